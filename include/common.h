@@ -57,6 +57,52 @@ extern "C"
     #define snprintf _snprintf
     #endif
 
+    //Thread local storage for per-thread state. Only use this on simple types (pointers, integers, plain structures) since some compilers cannot run constructors for it.
+    #if defined (_MSC_VER)
+    #define OPENSEA_THREAD_LOCAL __declspec(thread)
+    #else //GCC, clang, and compilers that emulate GCC
+    #define OPENSEA_THREAD_LOCAL __thread
+    #endif
+
+    //For small helpers defined in headers. Older Microsoft compilers only accept __inline in C files.
+    #if defined (_MSC_VER)
+    #define OPENSEA_INLINE __inline
+    #else
+    #define OPENSEA_INLINE inline
+    #endif
+
+    //Atomic operations on 32bit values and pointers for sharing state between threads without a lock.
+    //Loads are acquire, stores are release, and compare exchanges are acquire/release. Increment is relaxed and is meant for counters.
+    #if defined (_MSC_VER)
+    //The Interlocked functions are full barriers, which is stronger than needed but always correct
+    #define M_Atomic_Load(ptr) ((uint32_t)InterlockedOr((volatile LONG*)(ptr), 0))
+    #define M_Atomic_Store(ptr, value) InterlockedExchange((volatile LONG*)(ptr), (LONG)(value))
+    #define M_Atomic_Compare_Exchange(ptr, expected, desired) (InterlockedCompareExchange((volatile LONG*)(ptr), (LONG)(desired), (LONG)(expected)) == (LONG)(expected))
+    #define M_Atomic_Increment(ptr) InterlockedIncrement((volatile LONG*)(ptr))
+    #define M_Atomic_Load_Pointer(ptr) InterlockedCompareExchangePointer((PVOID volatile*)(ptr), NULL, NULL)
+    #define M_Atomic_Compare_Exchange_Pointer(ptr, expected, desired) (InterlockedCompareExchangePointer((PVOID volatile*)(ptr), (PVOID)(desired), (PVOID)(expected)) == (PVOID)(expected))
+    #else //GCC, clang, and compilers that emulate GCC
+    #define M_Atomic_Load(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define M_Atomic_Store(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define M_Atomic_Compare_Exchange(ptr, expected, desired) __extension__({ uint32_t atomicExpected = (expected); __atomic_compare_exchange_n((ptr), &atomicExpected, (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); })
+    #define M_Atomic_Increment(ptr) __atomic_add_fetch((ptr), 1, __ATOMIC_RELAXED)
+    #define M_Atomic_Load_Pointer(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define M_Atomic_Compare_Exchange_Pointer(ptr, expected, desired) __extension__({ __typeof__(expected) atomicExpected = (expected); __atomic_compare_exchange_n((ptr), &atomicExpected, (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); })
+    #endif
+
+    //x86 and x86_64 CPUs. Code using instructions past SSE2 on these must check get_CPU_Features before calling it.
+    #if defined (__x86_64__) || defined (__i386__) || defined (_M_X64) || defined (_M_AMD64) || defined (_M_IX86)
+    #define OPENSEA_CPU_X86
+    #endif
+
+    //Lets one function use instructions that are not enabled for the rest of the build so that it can be picked at runtime with get_CPU_Features.
+    //MSVC allows any intrinsic without this.
+    #if defined (__GNUC__) || defined (__clang__)
+    #define OPENSEA_TARGET(isa) __attribute__((target(isa)))
+    #else
+    #define OPENSEA_TARGET(isa)
+    #endif
+
     //get a specific double word
     #define M_DoubleWord0(l) ( (uint32_t) ( ( (l) & 0x00000000FFFFFFFFULL ) >>  0 ) )
     #define M_DoubleWord1(l) ( (uint32_t) ( ( (l) & 0xFFFFFFFF00000000ULL ) >> 32 ) )
@@ -264,14 +310,17 @@ extern "C"
     #define  M_Min(a,b)    (((a)<(b))?(a):(b))
     #define  M_Max(a,b)    (((a)>(b))?(a):(b))
 
+    //marks a parameter or variable as intentionally unused to silence compiler warnings
+    #define M_USE_UNUSED(x) (void)(x)
+
     typedef enum _eOutputFormat
     {
         SEAC_OUTPUT_TEXT, //default way everything is output
         SEAC_OUTPUT_RAW,  //This will output the data as raw binary glob
+        //JSON, CSV, and XML are written with the outputWriter in common_output.h
         SEAC_OUTPUT_JSON,
-        //TODO: add other output formats as we want to support them
-        SEAC_OUTPUT_CSV, //just an idea...isn't implemented now
-        SEAC_OUTPUT_XML, //just an idea...isn't implemented now
+        SEAC_OUTPUT_CSV,
+        SEAC_OUTPUT_XML,
     }eOutputFormat;
 
 
@@ -458,6 +507,60 @@ extern "C"
     //-----------------------------------------------------------------------------
     void double_Word_Swap_64(uint64_t *quadWordToSwap);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  load_Little_Endian_32() / load_Little_Endian_64()
+    //
+    //! \brief   Description:  Reads a little endian value from a byte buffer that may not be aligned, on any host. Compilers turn this into a single load
+    //!                        on little endian CPUs. Defined here so that it is inlined into the hash and checksum loops that use it.
+    //
+    //  Entry:
+    //!   \param[in] data = pointer to the first byte of the value
+    //!
+    //  Exit:
+    //!   \return the value in host byte order
+    //
+    //-----------------------------------------------------------------------------
+    static OPENSEA_INLINE uint32_t load_Little_Endian_32(const uint8_t *data)
+    {
+        return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    }
+
+    static OPENSEA_INLINE uint64_t load_Little_Endian_64(const uint8_t *data)
+    {
+        return (uint64_t)data[0] | ((uint64_t)data[1] << 8) | ((uint64_t)data[2] << 16) | ((uint64_t)data[3] << 24)
+            | ((uint64_t)data[4] << 32) | ((uint64_t)data[5] << 40) | ((uint64_t)data[6] << 48) | ((uint64_t)data[7] << 56);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //  store_Little_Endian_32() / store_Little_Endian_64()
+    //
+    //! \brief   Description:  Writes a value to a byte buffer that may not be aligned in little endian byte order, on any host.
+    //!                        The opposite of load_Little_Endian_32/64, for data that is read back on other systems.
+    //
+    //  Entry:
+    //!   \param[out] data = pointer to where the first byte of the value goes
+    //!   \param[in] value = value to write
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    static OPENSEA_INLINE void store_Little_Endian_32(uint8_t *data, uint32_t value)
+    {
+        data[0] = (uint8_t)value;
+        data[1] = (uint8_t)(value >> 8);
+        data[2] = (uint8_t)(value >> 16);
+        data[3] = (uint8_t)(value >> 24);
+    }
+
+    static OPENSEA_INLINE void store_Little_Endian_64(uint8_t *data, uint64_t value)
+    {
+        store_Little_Endian_32(data, (uint32_t)value);
+        store_Little_Endian_32(data + 4, (uint32_t)(value >> 32));
+    }
+
     //-----------------------------------------------------------------------------
     //
     //  celsius_To_Fahrenheit()
@@ -701,6 +804,88 @@ extern "C"
     //-----------------------------------------------------------------------------
     void print_Data_Buffer(uint8_t *dataBuffer, uint32_t bufferLen, bool showPrint);
 
+    typedef struct _dataDumpOptions
+    {
+        FILE *outputFile;//stream to write the dump to. If this is NULL, outputDescriptor is used instead.
+        int outputDescriptor;//OS file descriptor to write the dump to when outputFile is NULL.
+        uint64_t baseOffset;//added to each offset that is printed. Use this when dumping a piece of a larger buffer or file.
+        bool showPrint;//show printable characters on the side of the hex output. Non-printable characters will be represented as dots.
+        uint32_t threadCount;//number of threads to format the output with. 0 = pick based on the number of processors. 1 = format on the calling thread only.
+        bool collapseRepeatedLines;//lines that are the same as the line before them are replaced with a single "*" for each run, like hexdump does.
+    }dataDumpOptions, *ptrDataDumpOptions;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  dump_Data_Buffer()
+    //
+    //! \brief   Description:  print out a data buffer to a file or file descriptor in the same format as print_Data_Buffer.
+    //!                        Large buffers are split into chunks that are formatted on worker threads and written out in order.
+    //
+    //  Entry:
+    //!   \param[in] dataBuffer = a pointer to the data buffer you want to print out
+    //!   \param[in] bufferLen = the length that you want to print out. This can be the length of the buffer, or anything less than that
+    //!   \param[in] options = pointer to the options describing where and how to dump the buffer
+    //!
+    //  Exit:
+    //!   \return SUCCESS = buffer written. BAD_PARAMETER = invalid input, MEMORY_FAILURE = could not allocate formatting buffers, FAILURE = error writing to the output
+    //
+    //-----------------------------------------------------------------------------
+    int dump_Data_Buffer(const uint8_t *dataBuffer, uint64_t bufferLen, ptrDataDumpOptions options);
+
+    typedef struct _dataCompareResult
+    {
+        uint64_t differentBytes;//number of bytes that did not match
+        uint64_t differentLines;//number of 16 byte lines containing at least one byte that did not match
+        uint64_t firstDifferenceOffset;//offset of the first byte that did not match. Only valid when differentBytes is nonzero
+    }dataCompareResult, *ptrDataCompareResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  print_Data_Buffer_Differences()
+    //
+    //! \brief   Description:  compare two buffers 16 bytes at a time and print only the lines that are different to the screen.
+    //!                        Each different line is printed from both buffers with the different bytes highlighted, followed by totals.
+    //!                        The output is collected with the styled text functions, so colors are only used when stdout is a terminal.
+    //
+    //  Entry:
+    //!   \param[in] expectedBuffer = a pointer to the data that was expected (ex: what was written)
+    //!   \param[in] actualBuffer = a pointer to the data to compare against expectedBuffer (ex: what was read back)
+    //!   \param[in] bufferLen = the length of both buffers to compare
+    //!   \param[in] contextLines = number of matching lines to print before and after each line that is different
+    //!   \param[in] showPrint = set to true to show printable characters on the side of the hex output for the buffer. Non-printable characters will be represented as dots.
+    //!   \param[out] result = optional pointer to receive the number of differences found. Can be NULL.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = buffers match, FAILURE = buffers are different, BAD_PARAMETER = invalid input, MEMORY_FAILURE = could not allocate the output buffer
+    //
+    //-----------------------------------------------------------------------------
+    int print_Data_Buffer_Differences(const uint8_t *expectedBuffer, const uint8_t *actualBuffer, uint64_t bufferLen, uint32_t contextLines, bool showPrint, ptrDataCompareResult result);
+
+    //flags returned by get_CPU_Features
+    #define CPU_FEATURE_SSE2        BIT0
+    #define CPU_FEATURE_SSSE3       BIT1
+    #define CPU_FEATURE_SSE4_2      BIT2
+    #define CPU_FEATURE_PCLMULQDQ   BIT3
+    #define CPU_FEATURE_AVX2        BIT4 //only set when the OS saves the AVX registers too
+    #define CPU_FEATURE_NEON        BIT5
+    #define CPU_FEATURE_ARM_CRC32   BIT6 //ARMv8 CRC32 and CRC32C instructions
+    #define CPU_FEATURE_INVARIANT_TSC BIT7 //the TSC counts at the same rate in every P, C, and T state
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_CPU_Features()
+    //
+    //! \brief   Description:  Gets the instruction set extensions the CPU running this code supports, for picking the fastest version of a function at runtime.
+    //!                        The CPU is only checked on the first call. Later calls return the saved result.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return CPU_FEATURE_ flags for the supported extensions
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t get_CPU_Features(void);
+
     //-----------------------------------------------------------------------------
     //
     //  print_Return_Enum()
@@ -717,6 +902,114 @@ extern "C"
     //-----------------------------------------------------------------------------
     void print_Return_Enum(char *funcName, int ret);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Return_Enum_Name() / get_Return_Enum_Description()
+    //
+    //! \brief   Description:  Looks up the name (as shown by print_Return_Enum) or a longer description of an eReturnValue in a constant table. Nothing is allocated or printed.
+    //
+    //  Entry:
+    //!   \param[in] ret = value to look up
+    //!
+    //  Exit:
+    //!   \return constant string. Values that are not in eReturnValues get "UNKNOWN"
+    //
+    //-----------------------------------------------------------------------------
+    const char* get_Return_Enum_Name(int ret);
+    const char* get_Return_Enum_Description(int ret);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  format_Return_Enum()
+    //
+    //! \brief   Description:  Writes the same text as print_Return_Enum into a caller provided buffer instead of printing it, without the trailing newlines.
+    //
+    //  Entry:
+    //!   \param[in] funcName = Name of function value returning from. Can be NULL.
+    //!   \param[in] ret = value to humanize
+    //!   \param[in] includeDescription = true to add the description after the name
+    //!   \param[out] buffer = where to write the text. Always NULL terminated when bufferSize > 0.
+    //!   \param[in] bufferSize = size of buffer in bytes
+    //!
+    //  Exit:
+    //!   \return length of the full text, not counting the NULL terminator. If this is >= bufferSize, the text was truncated.
+    //
+    //-----------------------------------------------------------------------------
+    size_t format_Return_Enum(const char *funcName, int ret, bool includeDescription, char *buffer, size_t bufferSize);
+
+    //Each thread keeps its own ring of the last ERROR_HISTORY_DEPTH errors recorded with record_Error. Must be a power of 2.
+    #define ERROR_HISTORY_DEPTH 16
+
+    typedef struct _errorHistoryEntry
+    {
+        int returnValue;
+        const char *functionName;//pointer that was passed to record_Error
+        uint64_t timestamp;//same units as seatimer_t.timerStart. Put two of these in a seatimer_t and use get_Nano_Seconds to get the time between them.
+    }errorHistoryEntry, *ptrErrorHistoryEntry;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  record_Error()
+    //
+    //! \brief   Description:  Saves an error in the calling thread's error history. This only reads the monotonic timer and does a few stores, so it is cheap enough for hot loops.
+    //!                        Use the RECORD_ERROR macro to fill in the function name automatically.
+    //
+    //  Entry:
+    //!   \param[in] returnValue = error to save
+    //!   \param[in] functionName = name of the function with the error. Only the pointer is saved, so use a string literal (like __FUNCTION__).
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void record_Error(int returnValue, const char *functionName);
+
+    #define RECORD_ERROR(returnValue) record_Error(returnValue, __FUNCTION__)
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Error_History()
+    //
+    //! \brief   Description:  Copies the calling thread's saved errors, newest first.
+    //
+    //  Entry:
+    //!   \param[out] entries = where to copy the errors
+    //!   \param[in] maxEntries = number of entries that fit in entries
+    //!
+    //  Exit:
+    //!   \return number of entries copied. This is at most ERROR_HISTORY_DEPTH.
+    //
+    //-----------------------------------------------------------------------------
+    uint32_t get_Error_History(ptrErrorHistoryEntry entries, uint32_t maxEntries);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  clear_Error_History()
+    //
+    //! \brief   Description:  Removes all saved errors for the calling thread.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void clear_Error_History(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  print_Error_History()
+    //
+    //! \brief   Description:  Prints the calling thread's saved errors, newest first, with how long ago each one happened.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void print_Error_History(void);
+
     //-----------------------------------------------------------------------------
     //
     //  metric_Unit_Convert()
@@ -829,13 +1122,141 @@ extern "C"
     //-----------------------------------------------------------------------------
     void print_Time_To_Screen(uint8_t *years, uint8_t *days, uint8_t *hours, uint8_t *minutes, uint8_t *seconds);
 
-    extern uint32_t seed32Array[2];
-    extern uint64_t seed64Array[2];
+    //State for the xoshiro256** generator http://prng.di.unimi.it/ . Each randomState is its own stream, so threads that each use their own state never share or race on one.
+    //Streams made with split_Random_State or the jump functions are far enough apart in the generator's period that they never overlap.
+    typedef struct _randomState
+    {
+        uint64_t state[4];//must not be all zeros. Set it with seed_Random_State.
+    }randomState, *ptrRandomState;
+
+    //splitmix64 adds SPLITMIX64_INCREMENT to its state for each value, then mixes the state with two multiplies
+    #define SPLITMIX64_INCREMENT UINT64_C(0x9E3779B97F4A7C15)
+    #define SPLITMIX64_MULTIPLIER_1 UINT64_C(0xBF58476D1CE4E5B9)
+    #define SPLITMIX64_MULTIPLIER_2 UINT64_C(0x94D049BB133111EB)
+
+    //-----------------------------------------------------------------------------
+    //
+    //  rotate_Left_64()
+    //
+    //! \brief   Description:  Rotates a 64 bit value left. Compilers turn this into a single rotate instruction.
+    //!                        Defined here so that it is inlined into the random number and hash loops that use it.
+    //
+    //  Entry:
+    //!   \param[in] value = value to rotate
+    //!   \param[in] count = number of bits to rotate by, 1 to 63
+    //!
+    //  Exit:
+    //!   \return rotated value
+    //
+    //-----------------------------------------------------------------------------
+    static OPENSEA_INLINE uint64_t rotate_Left_64(uint64_t value, uint8_t count)
+    {
+        return (value << count) | (value >> (64 - count));
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //  splitmix64()
+    //
+    //! \brief   Description:  Generates the next value of a splitmix64 sequence http://prng.di.unimi.it/splitmix64.c . Every splitState value gives a different result,
+    //!                        which makes it good for expanding one seed into the several values a larger generator state needs.
+    //
+    //  Entry:
+    //!   \param[in,out] splitState = sequence position. Incremented by a constant on each call. Can start at any value.
+    //!
+    //  Exit:
+    //!   \return next value of the sequence
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t splitmix64(uint64_t *splitState);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  seed_Random_State()
+    //
+    //! \brief   Description:  Seeds a random state. The seed is expanded into the full state with splitmix64, so any seed (including 0) gives a usable, distinct stream.
+    //
+    //  Entry:
+    //!   \param[out] rng = random state to seed
+    //!   \param[in] seed = value to use as a seed for the random number generator
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void seed_Random_State(ptrRandomState rng, uint64_t seed);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  random_Next_64() / random_Next_32()
+    //
+    //! \brief   Description:  Generate the next (psuedo) random number from a random state using xoshiro256**. The 32bit version returns the upper half of a 64bit value.
+    //
+    //  Entry:
+    //!   \param[in,out] rng = random state to generate from
+    //!
+    //  Exit:
+    //!   \return random number
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t random_Next_64(ptrRandomState rng);
+    uint32_t random_Next_32(ptrRandomState rng);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  jump_Random_State() / long_Jump_Random_State()
+    //
+    //! \brief   Description:  Moves a random state ahead by 2^128 (jump) or 2^192 (long jump) values, the same as calling random_Next_64 that many times.
+    //!                        The default per thread states are long jumps apart, leaving jumps for splitting a thread's stream further.
+    //
+    //  Entry:
+    //!   \param[in,out] rng = random state to move ahead
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void jump_Random_State(ptrRandomState rng);
+    void long_Jump_Random_State(ptrRandomState rng);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  split_Random_State()
+    //
+    //! \brief   Description:  Makes a new stream from a random state. child gets the current stream and rng is jumped ahead 2^128 values, so the two never overlap.
+    //!                        Call this repeatedly to give each worker thread its own stream from one seed.
+    //
+    //  Entry:
+    //!   \param[in,out] rng = random state to split. It is jumped ahead.
+    //!   \param[out] child = receives the new stream
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void split_Random_State(ptrRandomState rng, ptrRandomState child);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Thread_Random_State()
+    //
+    //! \brief   Description:  Gets the calling thread's default random state, which seed_32, seed_64, xorshiftplus32, and xorshiftplus64 use.
+    //!                        The first call on each thread gives it the next stream from a shared state that is long jumped each time, so no two threads ever share values.
+    //!                        Threads get streams in the order they first ask for one. Call seed_Random_State on the result (or seed_64) for a repeatable stream.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return pointer to the calling thread's random state. Only use it from the calling thread.
+    //
+    //-----------------------------------------------------------------------------
+    ptrRandomState get_Thread_Random_State(void);
+
     //-----------------------------------------------------------------------------
     //
     //  seed_32()
     //
-    //! \brief   Description:  Takes a 32bit unsigned integer for the seed start and plugs it into the seed32Array in 0. 1 is filled with seed>>1, then the random number generator is run twice replacing each seed value in the array
+    //! \brief   Description:  Seeds the calling thread's default random state with seed_Random_State. Other threads are not affected.
     //
     //  Entry:
     //!   \param[in] seed = value to use as a seed for the random number generator
@@ -850,7 +1271,7 @@ extern "C"
     //
     //  seed_64()
     //
-    //! \brief   Description:  Takes a 64bit unsigned integer for the seed start and plugs it into the seed64Array in 0. 1 is filled with seed>>2, then the random number generator is run twice replacing each seed value in the array
+    //! \brief   Description:  Seeds the calling thread's default random state with seed_Random_State. Other threads are not affected.
     //
     //  Entry:
     //!   \param[in] seed = value to use as a seed for the random number generator
@@ -865,7 +1286,8 @@ extern "C"
     //
     //  xorshiftplus32()
     //
-    //! \brief   Description:  Generate a 32bit (psuedo) random number using the xorshiftplus alorithm http://en.wikipedia.org/wiki/Xorshift. This was chosen for implemtnation for being fast and light weight
+    //! \brief   Description:  Generate a 32bit (psuedo) random number from the calling thread's default random state. Same as random_Next_32(get_Thread_Random_State()).
+    //!                        The name is kept from when this used a global xorshift+ generator.
     //
     //  Entry:
     //!
@@ -879,7 +1301,8 @@ extern "C"
     //
     //  xorshiftplus64()
     //
-    //! \brief   Description:  Generate a 64bit (psuedo) random number using the xorshiftplus alorithm http://en.wikipedia.org/wiki/Xorshift. This was chosen for implemtnation for being fast and light weight
+    //! \brief   Description:  Generate a 64bit (psuedo) random number from the calling thread's default random state. Same as random_Next_64(get_Thread_Random_State()).
+    //!                        The name is kept from when this used a global xorshift+ generator.
     //
     //  Entry:
     //!
@@ -889,11 +1312,49 @@ extern "C"
     //-----------------------------------------------------------------------------
     uint64_t xorshiftplus64(void);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  multiply_64_To_128()
+    //
+    //! \brief   Description:  Multiplies two 64bit values and returns the full 128bit product. Uses the compiler's 128bit type or intrinsic when there is one.
+    //
+    //  Entry:
+    //!   \param[in] value1 = first value to multiply
+    //!   \param[in] value2 = second value to multiply
+    //!   \param[out] highBits = receives the upper 64 bits of the product
+    //!
+    //  Exit:
+    //!   \return lower 64 bits of the product
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t multiply_64_To_128(uint64_t value1, uint64_t value2, uint64_t *highBits);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  random_State_Range_32() / random_State_Range_64()
+    //
+    //! \brief   Description:  Generate an unbiased random number from rangeMin to rangeMax (inclusive) using the given random state.
+    //!                        Uses a multiply and shift instead of a division. Every value in the range is equally likely, including when rangeMax is the largest value of the type.
+    //!                        If rangeMin is greater than rangeMax they are swapped.
+    //
+    //  Entry:
+    //!   \param[in,out] rng = random state to generate from
+    //!   \param[in] rangeMin = value to use for minimum value of range
+    //!   \param[in] rangeMax = value to use for maximum value of range
+    //!
+    //  Exit:
+    //!   \return random number
+    //
+    //-----------------------------------------------------------------------------
+    uint32_t random_State_Range_32(ptrRandomState rng, uint32_t rangeMin, uint32_t rangeMax);
+    uint64_t random_State_Range_64(ptrRandomState rng, uint64_t rangeMin, uint64_t rangeMax);
+
     //-----------------------------------------------------------------------------
     //
     //  random_Range_32()
     //
-    //! \brief   Description:  Generate a 32bit (psuedo) random number using the xorshiftplus alorithm within the specified range (slightly biased)
+    //! \brief   Description:  Generate an unbiased 32bit (psuedo) random number within the specified range (inclusive) from the calling thread's default random state.
+    //!                        Same as random_State_Range_32(get_Thread_Random_State(), rangeMin, rangeMax)
     //
     //  Entry:
     //!   \param[in] rangeMin = value to use for minimum value of range
@@ -909,7 +1370,8 @@ extern "C"
     //
     //  random_Range_64()
     //
-    //! \brief   Description:  Generate a 64bit (psuedo) random number using the xorshiftplus alorithm within the specified range (slightly biased)
+    //! \brief   Description:  Generate an unbiased 64bit (psuedo) random number within the specified range (inclusive) from the calling thread's default random state.
+    //!                        Same as random_State_Range_64(get_Thread_Random_State(), rangeMin, rangeMax)
     //
     //  Entry:
     //!   \param[in] rangeMin = value to use for minimum value of range
@@ -928,6 +1390,8 @@ extern "C"
     //  fill_Random_Pattern_In_Buffer(uint8_t *ptrData, uint32_t dataLength)
     //
     //! \brief   Description:  Fills a buffer with random data. Data length must be at least sizeof(uint32_t) in size (4 bytes)
+    //!                        The whole buffer is filled, including any bytes past the last multiple of 4.
+    //!                        The seed comes from get_Thread_Random_State(). Use fill_Seeded_Random_Pattern_In_Buffer when the data needs to be made again later.
     //
     //  Entry:
     //!   \param[out] ptrData = pointer to the data buffer to fill
@@ -1330,9 +1794,26 @@ extern "C"
     //
     //-----------------------------------------------------------------------------
     void *realloc_page_aligned(void *alignedPtr, size_t originalSize, size_t size);
-    //checks if the provided pointer memory is all cleared to zero or not.
+    //checks if the provided pointer memory is all cleared to zero or not. A length of 0 is empty.
     bool is_Empty(void *ptrData, size_t lengthBytes);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  find_First_Nonzero_Byte()
+    //
+    //! \brief   Description:  Finds the first byte of a buffer that is not zero. Checks 64 bytes at a time with AVX2, SSE2, or NEON and stops at the first nonzero one,
+    //!                        so it is fast both for proving a large buffer is cleared and for rejecting one that is not.
+    //
+    //  Entry:
+    //!   \param[in] ptrData = pointer to the data to check
+    //!   \param[in] lengthBytes = size of the data in bytes
+    //!
+    //  Exit:
+    //!   \return offset of the first nonzero byte. lengthBytes when every byte is zero, or when ptrData is NULL.
+    //
+    //-----------------------------------------------------------------------------
+    size_t find_First_Nonzero_Byte(const void *ptrData, size_t lengthBytes);
+
     //This function checks if the provided character is between 0 and 7F. A.K.A. part of the standard ascii character set.
     int is_ASCII(int c);
 
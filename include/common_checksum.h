@@ -0,0 +1,88 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_checksum.h
+// \brief Defines CRC32C and CRC64 checksums of data buffers, using CPU instructions for them when available
+//
+#pragma once
+
+#include "common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //Both CRCs follow the zlib crc32() convention: start with 0, then pass the previous result back in to continue over more data.
+    //update_CRC32C(0, "123456789", 9) == 0xE3069283 and update_CRC64(0, "123456789", 9) == 0xAE8B14860A799888
+    #define CRC32C_START_VALUE UINT32_C(0)
+    #define CRC64_START_VALUE UINT64_C(0)
+
+    //-----------------------------------------------------------------------------
+    //
+    //  update_CRC32C()
+    //
+    //! \brief   Description:  Calculates the CRC32C (Castagnoli, as used by iSCSI, ext4, and NVMe 32b guard protection information) of a buffer,
+    //!                        or continues one from a previous call. Picks the fastest version at runtime:
+    //!                        SSE4.2 or ARMv8 CRC32 instructions over 3 interleaved streams, or a slicing-by-8 table.
+    //
+    //  Entry:
+    //!   \param[in] crc = CRC32C_START_VALUE, or the result of the previous call for the data before this buffer
+    //!   \param[in] data = data to checksum. Can be NULL when length is 0.
+    //!   \param[in] length = number of bytes of data
+    //!
+    //  Exit:
+    //!   \return CRC32C of all the data so far
+    //
+    //-----------------------------------------------------------------------------
+    uint32_t update_CRC32C(uint32_t crc, const void *data, size_t length);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  update_CRC64()
+    //
+    //! \brief   Description:  Calculates the CRC64 used by NVMe 64b guard protection information (CRC-64/NVME, reflected polynomial 0x9A6C9329AC4BC9B5)
+    //!                        of a buffer, or continues one from a previous call. Uses PCLMULQDQ folding when the CPU has it, or a slicing-by-8 table.
+    //
+    //  Entry:
+    //!   \param[in] crc = CRC64_START_VALUE, or the result of the previous call for the data before this buffer
+    //!   \param[in] data = data to checksum. Can be NULL when length is 0.
+    //!   \param[in] length = number of bytes of data
+    //!
+    //  Exit:
+    //!   \return CRC64 of all the data so far
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t update_CRC64(uint64_t crc, const void *data, size_t length);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  calculate_Sector_CRC32C() / calculate_Sector_CRC64()
+    //
+    //! \brief   Description:  Calculates a separate CRC for each sector of a buffer, such as for per-LBA end to end data protection.
+    //!                        With the CRC32 instructions, 3 sectors are done at once so the instruction's latency is hidden.
+    //
+    //  Entry:
+    //!   \param[in] data = buffer holding sectorCount sectors
+    //!   \param[in] sectorSize = size of each sector in bytes
+    //!   \param[in] sectorCount = number of sectors in the buffer
+    //!   \param[out] crcs = receives one CRC per sector, each started from the start value
+    //!
+    //  Exit:
+    //!   \return SUCCESS = CRCs calculated. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int calculate_Sector_CRC32C(const uint8_t *data, uint32_t sectorSize, size_t sectorCount, uint32_t *crcs);
+    int calculate_Sector_CRC64(const uint8_t *data, uint32_t sectorSize, size_t sectorCount, uint64_t *crcs);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
@@ -0,0 +1,111 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_encode.h
+// \brief Defines hex and base64 encoding and decoding of binary data into caller provided buffers
+//
+#pragma once
+
+#include "common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //Buffer sizes needed for the functions below. The encoded lengths do not include a NULL terminator.
+    #define HEX_ENCODED_LENGTH(dataLength) ((dataLength) * 2)
+    #define BASE64_ENCODED_LENGTH(dataLength) ((((dataLength) + 2) / 3) * 4)
+    #define BASE64_DECODED_MAX_LENGTH(encodedLength) ((((encodedLength) + 3) / 4) * 3)
+
+    //-----------------------------------------------------------------------------
+    //
+    //  hex_Encode()
+    //
+    //! \brief   Description:  Converts binary data to hex characters, two per byte with the high nibble first and no separators.
+    //!                        Uses SSSE3, AVX2, or NEON when the CPU has them.
+    //
+    //  Entry:
+    //!   \param[in] data = data to encode
+    //!   \param[in] dataLength = number of bytes of data
+    //!   \param[out] output = buffer to receive the hex characters. A NULL terminator is added when there is room for it.
+    //!   \param[in] outputSize = size of output. Must be at least HEX_ENCODED_LENGTH(dataLength).
+    //!   \param[in] upperCase = true for A-F, false for a-f
+    //!
+    //  Exit:
+    //!   \return SUCCESS = encoded, BAD_PARAMETER = invalid pointer or output is too small
+    //
+    //-----------------------------------------------------------------------------
+    int hex_Encode(const uint8_t *data, size_t dataLength, char *output, size_t outputSize, bool upperCase);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  hex_Decode()
+    //
+    //! \brief   Description:  Converts hex characters back to binary data. Upper and lower case are both accepted. Separators, spaces, and a 0x prefix are not.
+    //!                        Uses SSSE3, AVX2, or NEON when the CPU has them.
+    //
+    //  Entry:
+    //!   \param[in] hex = hex characters to decode. Does not need to be NULL terminated.
+    //!   \param[in] hexLength = number of characters in hex. Must be even.
+    //!   \param[out] output = buffer to receive the data
+    //!   \param[in] outputSize = size of output. Must be at least hexLength / 2.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = decoded, BAD_PARAMETER = invalid pointer, odd length, or output is too small, FAILURE = hex contains a character that is not a hex digit.
+    //!           output may have been partly written on FAILURE.
+    //
+    //-----------------------------------------------------------------------------
+    int hex_Decode(const char *hex, size_t hexLength, uint8_t *output, size_t outputSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  base64_Encode()
+    //
+    //! \brief   Description:  Converts binary data to standard base64 (RFC 4648 alphabet with + and /) with = padding and no line breaks.
+    //!                        Uses SSSE3, AVX2, or NEON when the CPU has them.
+    //
+    //  Entry:
+    //!   \param[in] data = data to encode
+    //!   \param[in] dataLength = number of bytes of data
+    //!   \param[out] output = buffer to receive the base64 characters. A NULL terminator is added when there is room for it.
+    //!   \param[in] outputSize = size of output. Must be at least BASE64_ENCODED_LENGTH(dataLength).
+    //!
+    //  Exit:
+    //!   \return SUCCESS = encoded, BAD_PARAMETER = invalid pointer or output is too small
+    //
+    //-----------------------------------------------------------------------------
+    int base64_Encode(const uint8_t *data, size_t dataLength, char *output, size_t outputSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  base64_Decode()
+    //
+    //! \brief   Description:  Converts standard base64 back to binary data. The = padding at the end is optional. Line breaks and other whitespace are not accepted.
+    //!                        Uses SSSE3, AVX2, or NEON when the CPU has them.
+    //
+    //  Entry:
+    //!   \param[in] base64 = base64 characters to decode. Does not need to be NULL terminated.
+    //!   \param[in] base64Length = number of characters in base64, including any padding
+    //!   \param[out] output = buffer to receive the data
+    //!   \param[in] outputSize = size of output. BASE64_DECODED_MAX_LENGTH(base64Length) is always big enough.
+    //!   \param[out] decodedLength = number of bytes written to output
+    //!
+    //  Exit:
+    //!   \return SUCCESS = decoded, BAD_PARAMETER = invalid pointer or output is too small, FAILURE = base64 contains an invalid character, misplaced padding, or an impossible length.
+    //!           output may have been partly written on FAILURE.
+    //
+    //-----------------------------------------------------------------------------
+    int base64_Decode(const char *base64, size_t base64Length, uint8_t *output, size_t outputSize, size_t *decodedLength);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
@@ -0,0 +1,150 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_hash.h
+// \brief Defines fast non-cryptographic 64 and 128 bit hashes of data buffers, for finding duplicate or changed data
+//
+#pragma once
+
+#include "common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //The hash works like xxHash3: inputs up to HASH_SHORT_LENGTH bytes are mixed directly, and longer ones go through
+    //HASH_LANES accumulators that take one HASH_STRIPE_SIZE stripe at a time (with AVX2 or NEON when available).
+    //Data is always read as little endian, so a hash is the same on every system. It is NOT suitable where an attacker picks the data.
+    #define HASH_LANES 8
+    #define HASH_STRIPE_SIZE (HASH_LANES * 8)
+    #define HASH_SHORT_LENGTH 128
+    #define HASH_SECRET_WORDS 24 //keys mixed with the data, made from the seed
+    #define HASH_STATE_BUFFER_SIZE (HASH_STRIPE_SIZE * 4)
+
+    typedef struct _hash128
+    {
+        uint64_t low;
+        uint64_t high;
+    }hash128;
+
+    //one piece of a scatter-gather list
+    typedef struct _hashSegment
+    {
+        const void *data;
+        size_t length;
+    }hashSegment;
+
+    //Streaming state for hashing data that arrives in pieces. Treat the contents as private.
+    typedef struct _hashState
+    {
+        uint64_t accumulators[HASH_LANES];
+        uint64_t secret[HASH_SECRET_WORDS];
+        uint64_t seed;
+        uint64_t totalLength;
+        uint32_t bufferedLength;
+        uint32_t stripesInBlock;
+        uint8_t buffer[HASH_STATE_BUFFER_SIZE];//data not accumulated yet. The last stripe is always held back until the hash is read.
+        uint8_t lastStripe[HASH_STRIPE_SIZE];//last stripe that was accumulated, for when buffer holds less than a stripe
+    }hashState, *ptrHashState;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  hash_Buffer_64() / hash_Buffer_128()
+    //
+    //! \brief   Description:  Hashes a buffer. Different seeds give unrelated hashes of the same data.
+    //!                        The 128 bit hash has a 64 bit hash of its own in each half, for when a 64 bit hash could collide too often, such as
+    //!                        comparing billions of blocks. The low half is not the same as hash_Buffer_64.
+    //
+    //  Entry:
+    //!   \param[in] seed = seed for the hash. Use 0 when there is no reason to pick one.
+    //!   \param[in] data = data to hash. Can be NULL when length is 0.
+    //!   \param[in] length = number of bytes of data
+    //!
+    //  Exit:
+    //!   \return hash of the data
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t hash_Buffer_64(uint64_t seed, const void *data, size_t length);
+    hash128 hash_Buffer_128(uint64_t seed, const void *data, size_t length);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  hash_Segments_64() / hash_Segments_128()
+    //
+    //! \brief   Description:  Hashes a scatter-gather list. The result is the same as hash_Buffer_64/128 of all the segments copied together in order.
+    //
+    //  Entry:
+    //!   \param[in] seed = seed for the hash
+    //!   \param[in] segments = list of the pieces of data
+    //!   \param[in] segmentCount = number of entries in segments
+    //!   \param[out] hash = receives the hash of the data
+    //!
+    //  Exit:
+    //!   \return SUCCESS = data hashed. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int hash_Segments_64(uint64_t seed, const hashSegment *segments, size_t segmentCount, uint64_t *hash);
+    int hash_Segments_128(uint64_t seed, const hashSegment *segments, size_t segmentCount, hash128 *hash);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  init_Hash_State()
+    //
+    //! \brief   Description:  Starts a streaming hash. Data is added with update_Hash_State, and the hash can be read at any point with
+    //!                        get_Hash_State_64/128. The result is the same as hash_Buffer_64/128 of all the data added so far.
+    //
+    //  Entry:
+    //!   \param[out] state = state to set up
+    //!   \param[in] seed = seed for the hash
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void init_Hash_State(ptrHashState state, uint64_t seed);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  update_Hash_State()
+    //
+    //! \brief   Description:  Adds data to a streaming hash. Pieces of any size can be added.
+    //
+    //  Entry:
+    //!   \param[in,out] state = state set up by init_Hash_State
+    //!   \param[in] data = data to add. Can be NULL when length is 0.
+    //!   \param[in] length = number of bytes of data
+    //!
+    //  Exit:
+    //!   \return SUCCESS = data added. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int update_Hash_State(ptrHashState state, const void *data, size_t length);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Hash_State_64() / get_Hash_State_128()
+    //
+    //! \brief   Description:  Reads the hash of all the data added to a streaming hash so far. The state is not changed, so more data can still be added.
+    //
+    //  Entry:
+    //!   \param[in] state = state set up by init_Hash_State
+    //!
+    //  Exit:
+    //!   \return hash of the data
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t get_Hash_State_64(const hashState *state);
+    hash128 get_Hash_State_128(const hashState *state);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
@@ -0,0 +1,184 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_histogram.h
+// \brief Defines a high dynamic range histogram for recording latencies and reporting their percentiles
+//
+#pragma once
+
+#include "common.h"
+#include "common_output.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //The histogram works like HdrHistogram: each power of 2 range of values is split into the same number of linear sub-buckets, so every
+    //recorded value is kept to within the requested number of significant decimal digits from 1 up to the highest trackable value.
+    //Recording is a few shifts and an increment. A histogram is not thread safe, so give each thread its own and merge them for reporting.
+    #define HISTOGRAM_DEFAULT_SIGNIFICANT_DIGITS 3
+    #define HISTOGRAM_MAX_SIGNIFICANT_DIGITS 5
+    #define HISTOGRAM_DEFAULT_HIGHEST_VALUE (UINT64_C(60) * 1000000000) //60 seconds in nanoseconds
+
+    typedef struct _latencyHistogram
+    {
+        uint64_t highestTrackableValue;//larger values are counted as this value. minValue and maxValue are still exact.
+        uint8_t significantDigits;
+        uint8_t subBucketHalfCountMagnitude;
+        uint32_t subBucketHalfCount;
+        uint64_t subBucketMask;
+        uint32_t countsLength;
+        uint64_t *counts;
+        uint64_t totalCount;
+        uint64_t minValue;//only valid when totalCount is not 0
+        uint64_t maxValue;
+    }latencyHistogram, *ptrLatencyHistogram;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  init_Latency_Histogram()
+    //
+    //! \brief   Description:  Sets up an empty histogram. Memory use is 8 bytes * 2^ceil(log2(2 * 10^significantDigits)) / 2 for each power of 2
+    //!                        up to highestTrackableValue. Ex: 3 digits up to 60 seconds in nanoseconds is about 220KiB.
+    //
+    //  Entry:
+    //!   \param[out] histogram = histogram to set up. Must be freed with free_Latency_Histogram.
+    //!   \param[in] highestTrackableValue = largest value to keep to full precision. 0 = HISTOGRAM_DEFAULT_HIGHEST_VALUE
+    //!   \param[in] significantDigits = decimal digits of precision to keep, 1 to HISTOGRAM_MAX_SIGNIFICANT_DIGITS. 0 = HISTOGRAM_DEFAULT_SIGNIFICANT_DIGITS
+    //!
+    //  Exit:
+    //!   \return SUCCESS = histogram ready. BAD_PARAMETER = error in function parameters. MEMORY_FAILURE = could not allocate the counts
+    //
+    //-----------------------------------------------------------------------------
+    int init_Latency_Histogram(ptrLatencyHistogram histogram, uint64_t highestTrackableValue, uint8_t significantDigits);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Latency_Histogram()
+    //
+    //! \brief   Description:  Frees the memory used by a histogram set up by init_Latency_Histogram.
+    //
+    //  Entry:
+    //!   \param[in,out] histogram = histogram to free
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void free_Latency_Histogram(ptrLatencyHistogram histogram);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  reset_Latency_Histogram()
+    //
+    //! \brief   Description:  Clears all recorded values, keeping the histogram's settings and memory.
+    //
+    //  Entry:
+    //!   \param[in,out] histogram = histogram set up by init_Latency_Histogram
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void reset_Latency_Histogram(ptrLatencyHistogram histogram);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  record_Histogram_Value() / record_Histogram_Timer()
+    //
+    //! \brief   Description:  Records one value, or the nanoseconds between a timer's start and stop.
+    //
+    //  Entry:
+    //!   \param[in,out] histogram = histogram set up by init_Latency_Histogram
+    //!   \param[in] value = value to record
+    //!   \param[in] timer = timer that has been started and stopped
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void record_Histogram_Value(ptrLatencyHistogram histogram, uint64_t value);
+    void record_Histogram_Timer(ptrLatencyHistogram histogram, seatimer_t timer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  merge_Latency_Histogram()
+    //
+    //! \brief   Description:  Adds everything recorded in one histogram to another, such as to combine the histograms of several threads or drives.
+    //!                        Histograms with the same settings are added bucket by bucket. Otherwise each of the source's buckets is recorded in the
+    //!                        destination at its middle value, so the result has the precision of the less precise of the two.
+    //
+    //  Entry:
+    //!   \param[in,out] destination = histogram to add to
+    //!   \param[in] source = histogram to add
+    //!
+    //  Exit:
+    //!   \return SUCCESS = merged. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int merge_Latency_Histogram(ptrLatencyHistogram destination, const latencyHistogram *source);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Histogram_Percentile()
+    //
+    //! \brief   Description:  Finds the value that percentile percent of the recorded values are less than or equal to.
+    //!                        The result is the highest value that is equivalent to the bucket the percentile falls in, but never more than maxValue.
+    //
+    //  Entry:
+    //!   \param[in] histogram = histogram set up by init_Latency_Histogram
+    //!   \param[in] percentile = percentile to find, 0 to 100. Ex: 99.99
+    //!
+    //  Exit:
+    //!   \return value at the percentile. 0 when nothing has been recorded.
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t get_Histogram_Percentile(const latencyHistogram *histogram, double percentile);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Histogram_Mean()
+    //
+    //! \brief   Description:  Calculates the mean of the recorded values from the middle value of each bucket.
+    //
+    //  Entry:
+    //!   \param[in] histogram = histogram set up by init_Latency_Histogram
+    //!
+    //  Exit:
+    //!   \return mean of the recorded values. 0 when nothing has been recorded.
+    //
+    //-----------------------------------------------------------------------------
+    double get_Histogram_Mean(const latencyHistogram *histogram);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  output_Latency_Histogram()
+    //
+    //! \brief   Description:  Writes a histogram's summary as an object: count, min, max, mean, and the p50, p90, p99, p99_9, p99_99 and p99_999 percentiles.
+    //!                        Optionally adds a "buckets" array with the highest equivalent value and count of each bucket that has values.
+    //!                        Works with every format the output writer supports, including text and JSON.
+    //
+    //  Entry:
+    //!   \param[in,out] writer = output writer set up by init_Output_Writer
+    //!   \param[in] name = name of the object. Can be NULL inside an array.
+    //!   \param[in] histogram = histogram to write
+    //!   \param[in] includeBuckets = true to write the buckets too
+    //!
+    //  Exit:
+    //!   \return SUCCESS, or the error code of the first error the writer encountered. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int output_Latency_Histogram(ptrOutputWriter writer, const char *name, const latencyHistogram *histogram, bool includeBuckets);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
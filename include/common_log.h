@@ -0,0 +1,133 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_log.h
+// \brief Defines an asynchronous logger that moves console and file output off of the threads issuing commands
+//
+#pragma once
+
+#include "common.h"
+#include <stdarg.h>
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //Each thread that logs gets its own queue of these records. Formatting is deferred to the writer thread, so a record holds the format string pointer and the raw argument values.
+    //Strings passed with %s are copied into the record since they may not exist by the time the record is written.
+    #define LOG_RECORD_MAX_ARGUMENTS 12 //conversions past this are not written
+    #define LOG_RECORD_STRING_SIZE 256 //total space for copied %s strings in one record. Longer strings are truncated.
+    #define LOG_DEFAULT_QUEUE_RECORDS 1024 //records in each thread's queue
+
+    typedef struct _logConfig
+    {
+        FILE *outputFile;//where the writer thread writes. NULL = stdout
+        uint32_t queueRecords;//records per thread queue. Rounded up to a power of 2. 0 = LOG_DEFAULT_QUEUE_RECORDS
+        bool dropWhenFull;//true = throw away records when a thread's queue is full. false = wait for the writer to make room
+    }logConfig, *ptrLogConfig;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  start_Logging()
+    //
+    //! \brief   Description:  Starts the background writer thread. Until this is called (and after stop_Logging), log_Printf writes synchronously like printf.
+    //
+    //  Entry:
+    //!   \param[in] config = logging options. Can be NULL to write to stdout with the default queue size.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = writer running, FAILURE = logging is already started or the writer thread could not be created
+    //
+    //-----------------------------------------------------------------------------
+    int start_Logging(ptrLogConfig config);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  stop_Logging()
+    //
+    //! \brief   Description:  Writes everything still queued, stops the writer thread, and frees all of the thread queues.
+    //!                        Other threads must be done logging before this is called.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return SUCCESS = stopped, FAILURE = logging was not started
+    //
+    //-----------------------------------------------------------------------------
+    int stop_Logging(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  flush_Log()
+    //
+    //! \brief   Description:  Formats and writes every record queued so far, then flushes the output file, before returning.
+    //!                        Use this before exiting on a fatal error so that nothing queued is lost. Can be called from any thread.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void flush_Log(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  log_Printf() / log_VPrintf()
+    //
+    //! \brief   Description:  printf replacement that queues a record for the writer thread instead of writing.
+    //!                        Supports the standard printf conversions (except %n and wide characters), including * width and precision.
+    //!                        Records from each thread are written in order. Records from different threads are written in timestamp order.
+    //
+    //  Entry:
+    //!   \param[in] format = printf format string. This pointer is stored in the record, so it must be a string literal or something else that stays valid until the record is written.
+    //!   \param[in] ... = arguments for the format string
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void log_Printf(const char *format, ...);
+    void log_VPrintf(const char *format, va_list args);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  release_Log_Thread_Queue()
+    //
+    //! \brief   Description:  Lets another thread reuse this thread's queue. Call this before a thread that has logged exits,
+    //!                        otherwise its queue is kept until stop_Logging. Anything already queued is still written.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void release_Log_Thread_Queue(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Log_Dropped_Count()
+    //
+    //! \brief   Description:  Gets the number of records thrown away because a queue was full. Only happens when dropWhenFull is set.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return number of records dropped since logging was started
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t get_Log_Dropped_Count(void);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
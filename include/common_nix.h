@@ -35,6 +35,9 @@ extern "C"
     #define SYSTEM_PATH_SEPARATOR '/'
     #define SYSTEM_PATH_SEPARATOR_STR "/"
 
+    #include <pthread.h> //worker threads are implemented with POSIX threads. Applications using them must link with -lpthread
+    typedef pthread_t osThreadHandle;
+
 #if defined (__cplusplus)
 }
 #endif
@@ -0,0 +1,188 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_output.h
+// \brief Defines a streaming writer for the structured eOutputFormat types (text, JSON, CSV, XML)
+//
+#pragma once
+
+#include "common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //The writer never allocates memory. Everything it needs is in the outputWriter structure, so allocate one per output and reuse it.
+    //JSON and XML output must have exactly one outermost object or array, and everything else goes inside of it. Writing a named field
+    //or a second item outside of it sets lastError to BAD_PARAMETER.
+    #define OUTPUT_WRITER_BUFFER_SIZE (16 * 1024) //output is collected here and written to the file when it fills up
+    #define OUTPUT_WRITER_CSV_HEADER_SIZE (4 * 1024) //CSV column names and the first row are held until the first row ends
+    #define OUTPUT_WRITER_NAME_STACK_SIZE 1024 //names of the currently open objects and arrays
+    #define OUTPUT_WRITER_MAX_DEPTH 32 //maximum nesting of objects and arrays
+
+    typedef struct _outputWriterLevel
+    {
+        bool isArray;
+        uint32_t childCount;
+        uint16_t nameOffset;//where this level's name starts in nameStack
+    }outputWriterLevel;
+
+    typedef struct _outputWriter
+    {
+        eOutputFormat outputFormat;
+        FILE *outputFile;
+        const char *rootName;//used as the XML root element name when the outermost object or array does not have a name
+        bool prettyPrint;//JSON and XML only. Put each item on its own line and indent it. Defaults to true.
+        int lastError;//first error encountered. Every call after an error returns this.
+        uint8_t depth;
+        outputWriterLevel levels[OUTPUT_WRITER_MAX_DEPTH + 1];//level 0 is outside of any object or array
+        char nameStack[OUTPUT_WRITER_NAME_STACK_SIZE];
+        uint16_t nameStackUsed;
+        //CSV state. Each object in an array becomes a row unless a row is already open. Fields in nested objects and arrays become columns named parent.child
+        uint8_t csvRowDepth;//0 when no row is open
+        uint32_t csvColumn;
+        bool csvHeaderWritten;
+        size_t csvHeaderUsed;
+        size_t csvFirstRowUsed;
+        size_t bufferUsed;
+        char csvHeader[OUTPUT_WRITER_CSV_HEADER_SIZE];
+        char csvFirstRow[OUTPUT_WRITER_CSV_HEADER_SIZE];
+        char buffer[OUTPUT_WRITER_BUFFER_SIZE];
+    }outputWriter, *ptrOutputWriter;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  init_Output_Writer()
+    //
+    //! \brief   Description:  Sets up an outputWriter to write the format in outputInfo to outputInfo's file pointer.
+    //!                        For XML, the utilityName in outputInfo will be used as the root element name when the outermost object does not have a name.
+    //!                        CSV output is a table. Each object in an array becomes a row, and the first row's field names become the header.
+    //!                        Fields written outside of a row are written as a "name,value" line in CSV.
+    //
+    //  Entry:
+    //!   \param[out] writer = pointer to the outputWriter to setup
+    //!   \param[in] outputInfo = format and file to write to. If outputFilePtr is NULL, stdout is used.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = writer ready. BAD_PARAMETER = invalid input. NOT_SUPPORTED = outputFormat is not a structured format (SEAC_OUTPUT_RAW)
+    //
+    //-----------------------------------------------------------------------------
+    int init_Output_Writer(ptrOutputWriter writer, OutputInfo *outputInfo);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  begin_Output_Object() / begin_Output_Array()
+    //
+    //! \brief   Description:  Opens an object or array. Must be matched with a call to end_Output_Object or end_Output_Array.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the outputWriter
+    //!   \param[in] name = name of the object or array. Ignored inside of arrays. Can be NULL.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, or the error code of the first error the writer encountered
+    //
+    //-----------------------------------------------------------------------------
+    int begin_Output_Object(ptrOutputWriter writer, const char *name);
+    int begin_Output_Array(ptrOutputWriter writer, const char *name);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  end_Output_Object() / end_Output_Array()
+    //
+    //! \brief   Description:  Closes the object or array that was opened last.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the outputWriter
+    //!
+    //  Exit:
+    //!   \return SUCCESS, or the error code of the first error the writer encountered. BAD_PARAMETER if the type does not match what was opened.
+    //
+    //-----------------------------------------------------------------------------
+    int end_Output_Object(ptrOutputWriter writer);
+    int end_Output_Array(ptrOutputWriter writer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  output_*_Field()
+    //
+    //! \brief   Description:  Writes a single named value to the current object or array. Values are escaped as needed for the output format.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the outputWriter
+    //!   \param[in] name = name of the field. Ignored inside of arrays.
+    //!   \param[in] value = value to write. A NULL string is written as null in JSON and as empty in other formats.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, or the error code of the first error the writer encountered
+    //
+    //-----------------------------------------------------------------------------
+    int output_String_Field(ptrOutputWriter writer, const char *name, const char *value);
+    int output_Unsigned_Field(ptrOutputWriter writer, const char *name, uint64_t value);
+    int output_Signed_Field(ptrOutputWriter writer, const char *name, int64_t value);
+    int output_Hex_Field(ptrOutputWriter writer, const char *name, uint64_t value);//written as a "0x" prefixed string
+    int output_Double_Field(ptrOutputWriter writer, const char *name, double value);
+    int output_Bool_Field(ptrOutputWriter writer, const char *name, bool value);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  output_Binary_Field()
+    //
+    //! \brief   Description:  Writes a buffer as a single string field, encoded as uppercase hex or base64 with hex_Encode or base64_Encode.
+    //!                        The data is encoded in pieces straight into the writer's buffer, so it can be any size outside of the first CSV row.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the outputWriter
+    //!   \param[in] name = name of the field. Ignored inside of arrays.
+    //!   \param[in] data = data to write
+    //!   \param[in] length = number of bytes of data
+    //!   \param[in] base64 = true to write base64, false to write hex
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER if data is NULL, or the error code of the first error the writer encountered
+    //
+    //-----------------------------------------------------------------------------
+    int output_Binary_Field(ptrOutputWriter writer, const char *name, const uint8_t *data, size_t length, bool base64);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  flush_Output_Writer()
+    //
+    //! \brief   Description:  Writes anything in the writer's buffer to the output file and flushes the file.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the outputWriter
+    //!
+    //  Exit:
+    //!   \return SUCCESS, or the error code of the first error the writer encountered
+    //
+    //-----------------------------------------------------------------------------
+    int flush_Output_Writer(ptrOutputWriter writer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  finish_Output_Writer()
+    //
+    //! \brief   Description:  Closes anything still open, then flushes the output. Call this once when all output has been written.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the outputWriter
+    //!
+    //  Exit:
+    //!   \return SUCCESS, or the error code of the first error the writer encountered
+    //
+    //-----------------------------------------------------------------------------
+    int finish_Output_Writer(ptrOutputWriter writer);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
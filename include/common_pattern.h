@@ -0,0 +1,460 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_pattern.h
+// \brief Defines fast data pattern generation for large buffers, such as the payloads for write tests
+//
+#pragma once
+
+#include "common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //Random fill generates RANDOM_FILL_LANES independent xoshiro256** streams in parallel (with AVX2 or NEON when available).
+    //Each step makes one 64 byte block: lane N's value is the 8 bytes at offset N * 8 of the block, in native byte order.
+    //The output is the same whichever SIMD path is used, so a buffer can be regenerated for comparison on any system with the same byte order.
+    #define RANDOM_FILL_LANES 8
+    #define RANDOM_FILL_BLOCK_SIZE (RANDOM_FILL_LANES * 8)
+
+    //Seeded fills restart the lanes every RANDOM_FILL_SEGMENT_SIZE bytes with a state made from the seed and the segment number,
+    //so any segment of a buffer can be made (or remade) without generating the segments before it.
+    #define RANDOM_FILL_SEGMENT_SIZE (64 * 1024)
+
+    #define PATTERN_FILL_STREAMING_LENGTH (4 * 1024 * 1024) //repeating pattern fills at least this long bypass the cache
+
+    typedef struct _randomFillState
+    {
+        uint64_t lanes[4][RANDOM_FILL_LANES];//xoshiro256** state, as [state word][lane] so each state word of every lane can be loaded at once
+    }randomFillState, *ptrRandomFillState;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  seed_Random_Fill_State()
+    //
+    //! \brief   Description:  Seeds the lanes of a random fill state for fill_Random_Pattern_From_State.
+    //!                        Each lane gets 4 values from a splitmix64 sequence started at the seed, so every lane is a different stream.
+    //!                        This is the same state fill_Seeded_Random_Pattern_In_Buffer uses for its first segment.
+    //
+    //  Entry:
+    //!   \param[out] fillState = random fill state to seed
+    //!   \param[in] seed = value to use as a seed
+    //!
+    //  Exit:
+    //!   \return void
+    //
+    //-----------------------------------------------------------------------------
+    void seed_Random_Fill_State(ptrRandomFillState fillState, uint64_t seed);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Random_Pattern_From_State()
+    //
+    //! \brief   Description:  Fills a buffer with the next values from a random fill state, so repeated calls continue the same streams.
+    //!                        Data is made in RANDOM_FILL_BLOCK_SIZE blocks. When dataLength is not a multiple of the block size, the rest of the last block is thrown away.
+    //
+    //  Entry:
+    //!   \param[in,out] fillState = random fill state set up by seed_Random_Fill_State
+    //!   \param[out] ptrData = pointer to the data buffer to fill
+    //!   \param[in] dataLength = size of the data buffer in bytes. Any length is allowed.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled buffer. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int fill_Random_Pattern_From_State(ptrRandomFillState fillState, uint8_t *ptrData, size_t dataLength);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Seeded_Random_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Fills a buffer with random data made from a seed. The same seed and length always make the same data,
+    //!                        and a shorter fill with the same seed makes the start of a longer one.
+    //!                        Every RANDOM_FILL_SEGMENT_SIZE bytes the lanes are reseeded from the seed and segment number.
+    //
+    //  Entry:
+    //!   \param[in] seed = value to use as a seed
+    //!   \param[out] ptrData = pointer to the data buffer to fill
+    //!   \param[in] dataLength = size of the data buffer in bytes. Any length is allowed.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled buffer. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int fill_Seeded_Random_Pattern_In_Buffer(uint64_t seed, uint8_t *ptrData, size_t dataLength);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Repeating_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Fills a buffer with copies of a pattern of any length, with a partial copy at the end when the length is not a multiple of the pattern.
+    //!                        The pattern is doubled in place into a block of about 32KiB, then the block is copied over the rest of the buffer, so short patterns
+    //!                        cost the same as long ones. Fills of PATTERN_FILL_STREAMING_LENGTH bytes or more use non-temporal stores on x86 so they do not
+    //!                        evict the cache that other threads (ex: verify threads) are working from.
+    //!                        fill_ASCII_Pattern_In_Buffer and fill_Pattern_Buffer_Into_Another_Buffer use this.
+    //
+    //  Entry:
+    //!   \param[in] pattern = pattern to repeat
+    //!   \param[in] patternLength = length of the pattern in bytes
+    //!   \param[out] ptrData = pointer to the data buffer to fill. Must not overlap the pattern.
+    //!   \param[in] dataLength = size of the data buffer in bytes. Any length is allowed.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled buffer. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int fill_Repeating_Pattern_In_Buffer(const uint8_t *pattern, size_t patternLength, uint8_t *ptrData, size_t dataLength);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_*_Pattern_In_Large_Buffer()
+    //
+    //! \brief   Description:  Fills buffers of any size with a pattern, splitting the work across threads when the buffer is large enough to benefit.
+    //!                        The data is the same no matter how many threads are used.
+    //!                        Hex: the 4 byte pattern (in native byte order) repeated through the whole buffer, including a partial copy at the end.
+    //!                        Incrementing: each byte is one more than the byte before it, starting from incrementStartValue and wrapping at 0xFF.
+    //!                        Seeded random: the same data as fill_Seeded_Random_Pattern_In_Buffer.
+    //
+    //  Entry:
+    //!   \param[in] hexPattern/incrementStartValue/seed = pattern to fill with
+    //!   \param[out] ptrData = pointer to the data buffer to fill
+    //!   \param[in] dataLength = size of the data buffer in bytes. Any length is allowed.
+    //!   \param[in] threadCount = maximum number of threads to use, including the calling thread. 0 = pick based on the number of processors. 1 = calling thread only.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled buffer. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int fill_Hex_Pattern_In_Large_Buffer(uint32_t hexPattern, uint8_t *ptrData, size_t dataLength, uint32_t threadCount);
+    int fill_Incrementing_Pattern_In_Large_Buffer(uint8_t incrementStartValue, uint8_t *ptrData, size_t dataLength, uint32_t threadCount);
+    int fill_Seeded_Random_Pattern_In_Large_Buffer(uint64_t seed, uint8_t *ptrData, size_t dataLength, uint32_t threadCount);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  random_Range_Array_32() / random_Range_Array_64()
+    //
+    //! \brief   Description:  Fills an array with unbiased random numbers from rangeMin to rangeMax (inclusive), such as a list of random LBAs.
+    //!                        The random bits come from fill_Random_Pattern_From_State and are scaled into the range with a multiply and shift (AVX2 for 32bit values when available).
+    //!                        The same state and arguments always give the same values, whichever SIMD path is used.
+    //!                        If rangeMin is greater than rangeMax they are swapped, like random_State_Range_32/64.
+    //
+    //  Entry:
+    //!   \param[in,out] fillState = random fill state set up by seed_Random_Fill_State
+    //!   \param[in] rangeMin = value to use for minimum value of range
+    //!   \param[in] rangeMax = value to use for maximum value of range
+    //!   \param[out] values = array to fill
+    //!   \param[in] count = number of values to generate
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled array. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int random_Range_Array_32(ptrRandomFillState fillState, uint32_t rangeMin, uint32_t rangeMax, uint32_t *values, size_t count);
+    int random_Range_Array_64(ptrRandomFillState fillState, uint64_t rangeMin, uint64_t rangeMax, uint64_t *values, size_t count);
+
+    #define PATTERN_VERIFY_DEFAULT_SECTOR_SIZE 512
+
+    typedef struct _patternVerifyResult
+    {
+        //set by the caller
+        uint32_t sectorSize;//size of the sectors tracked in sectorBitmap and differentSectors. 0 = PATTERN_VERIFY_DEFAULT_SECTOR_SIZE
+        uint8_t *sectorBitmap;//optional. Bit (N % 8) of byte (N / 8) is set when sector N has a byte that did not match. Cleared when the verify starts.
+        size_t sectorBitmapSize;//size of sectorBitmap in bytes. Sectors past the end of the bitmap are still counted in differentSectors.
+        //set by the verify
+        uint64_t differentBytes;//number of bytes that did not match
+        uint64_t differentSectors;//number of sectors containing at least one byte that did not match
+        uint64_t firstDifferenceOffset;//offset of the first byte that did not match. Only valid when differentBytes is nonzero
+        uint64_t lastDifferentSector;//used during the verify
+    }patternVerifyResult, *ptrPatternVerifyResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  verify_*_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Checks that a buffer (ex: data read back from a drive) holds the pattern made by the matching fill function.
+    //!                        The expected data is made again a piece at a time and compared with SIMD, so nothing needs to be kept from the fill.
+    //!                        Hex: the 4 byte pattern in native byte order over the whole buffer, as from fill_Hex_Pattern_In_Large_Buffer
+    //!                        (fill_Hex_Pattern_In_Buffer leaves the last dataLength % 4 bytes unchanged, so use a multiple of 4 with it).
+    //!                        Incrementing, ASCII, and pattern buffer: as from the fill functions with the same names.
+    //!                        Seeded random: as from fill_Seeded_Random_Pattern_In_Buffer or fill_Seeded_Random_Pattern_In_Large_Buffer with the same seed.
+    //!                        fill_Random_Pattern_In_Buffer picks its own seed, so use the seeded fill for data that will be verified.
+    //
+    //  Entry:
+    //!   \param[in] hexPattern/incrementStartValue/asciiPattern/inPattern/seed = pattern the buffer should hold
+    //!   \param[in] patternLength/inpatternLength = length of the ASCII pattern or pattern buffer
+    //!   \param[in] ptrData = pointer to the data buffer to check
+    //!   \param[in] dataLength = size of the data buffer in bytes
+    //!   \param[in,out] result = sector size and optional bitmap to fill in, and receives the totals
+    //!
+    //  Exit:
+    //!   \return SUCCESS = buffer matches. FAILURE = one or more bytes did not match. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int verify_Hex_Pattern_In_Buffer(uint32_t hexPattern, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result);
+    int verify_Incrementing_Pattern_In_Buffer(uint8_t incrementStartValue, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result);
+    int verify_ASCII_Pattern_In_Buffer(const char *asciiPattern, uint32_t patternLength, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result);
+    int verify_Pattern_Buffer_In_Another_Buffer(const uint8_t *inPattern, uint32_t inpatternLength, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result);
+    int verify_Seeded_Random_Pattern_In_Buffer(uint64_t seed, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Seekable_Random_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Fills a buffer with a piece of a random stream that can be started at any offset.
+    //!                        Each 8 byte word of the stream is made from the seed and its position alone (splitmix64 used as a counter), so the data for
+    //!                        any LBA can be made or checked on its own, in any order, and from any number of threads. Ex: streamOffset = LBA * logical sector size.
+    //!                        Filling bytes 0-99 and then 100-199 gives the same data as filling 0-199 in one call. Words are stored in native byte order.
+    //!                        Uses AVX2 when the CPU has it. This is a different stream than fill_Seeded_Random_Pattern_In_Buffer.
+    //
+    //  Entry:
+    //!   \param[in] seed = value to use as a seed
+    //!   \param[in] streamOffset = byte offset into the stream for the first byte of the buffer
+    //!   \param[out] ptrData = pointer to the data buffer to fill
+    //!   \param[in] dataLength = size of the data buffer in bytes. Any length is allowed.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled buffer. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int fill_Seekable_Random_Pattern_In_Buffer(uint64_t seed, uint64_t streamOffset, uint8_t *ptrData, size_t dataLength);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  verify_Seekable_Random_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Checks that a buffer holds the data fill_Seekable_Random_Pattern_In_Buffer makes for the same seed and stream offset.
+    //!                        Works like the other verify functions. Offsets and sectors in the result count from the start of the buffer, not the stream.
+    //
+    //  Entry:
+    //!   \param[in] seed = seed the data was made with
+    //!   \param[in] streamOffset = byte offset into the stream for the first byte of the buffer
+    //!   \param[in] ptrData = pointer to the data buffer to check
+    //!   \param[in] dataLength = size of the data buffer in bytes
+    //!   \param[in,out] result = sector size and optional bitmap to fill in, and receives the totals
+    //!
+    //  Exit:
+    //!   \return SUCCESS = buffer matches. FAILURE = one or more bytes did not match. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int verify_Seekable_Random_Pattern_In_Buffer(uint64_t seed, uint64_t streamOffset, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result);
+
+    //Tagged sectors start with a TAGGED_SECTOR_HEADER_SIZE byte header holding a signature, the pass number, the sector's LBA, the seed, the sector size,
+    //and a CRC32C of those fields as stored. The rest of the sector is seekable random data made from the seed, pass, and LBA, so a sector that was read back
+    //describes what it should hold and where it was supposed to be written. Header fields are little endian on every host.
+    #define TAGGED_SECTOR_HEADER_SIZE 32
+
+    typedef enum _eTaggedSectorStatus
+    {
+        TAGGED_SECTOR_GOOD,//header and data are exactly what was expected
+        TAGGED_SECTOR_MISDIRECTED,//an intact tagged sector, but for a different LBA. The write meant for that LBA landed here.
+        TAGGED_SECTOR_STALE,//an intact tagged sector for this LBA from a different pass or seed. The most recent write was lost.
+        TAGGED_SECTOR_CORRUPTED,//the header is damaged or missing, or the data does not match the header
+    }eTaggedSectorStatus;
+
+    typedef struct _taggedSectorVerifyResult
+    {
+        //set by the caller
+        eTaggedSectorStatus *sectorStatus;//optional. Receives the status of each sector in the buffer.
+        size_t sectorStatusCount;//number of entries in sectorStatus
+        //set by the verify
+        uint64_t goodSectors;
+        uint64_t misdirectedSectors;
+        uint64_t staleSectors;
+        uint64_t corruptedSectors;
+        uint64_t firstBadLBA;//LBA of the first sector that was not good. Only valid when goodSectors is less than the number of sectors
+    }taggedSectorVerifyResult, *ptrTaggedSectorVerifyResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Tagged_Sector_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Fills each sector in a buffer with a tagged sector for its LBA.
+    //
+    //  Entry:
+    //!   \param[in] seed = value to use as a seed
+    //!   \param[in] pass = pass number. Use a different pass each time the same LBAs are rewritten so lost writes can be found.
+    //!   \param[in] firstLBA = LBA of the first sector in the buffer
+    //!   \param[in] sectorSize = size of each sector in bytes. Must be larger than TAGGED_SECTOR_HEADER_SIZE.
+    //!   \param[out] ptrData = pointer to the data buffer to fill
+    //!   \param[in] dataLength = size of the data buffer in bytes. Must be a multiple of sectorSize.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled buffer. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int fill_Tagged_Sector_Pattern_In_Buffer(uint64_t seed, uint32_t pass, uint64_t firstLBA, uint32_t sectorSize, uint8_t *ptrData, size_t dataLength);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  verify_Tagged_Sector_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Checks that each sector in a buffer is the tagged sector fill_Tagged_Sector_Pattern_In_Buffer makes with the same arguments,
+    //!                        and sorts the ones that are not into misdirected, stale, or corrupted using the tag found in the sector.
+    //!                        Good sectors cost one header compare and one payload compare against regenerated data.
+    //
+    //  Entry:
+    //!   \param[in] seed = seed the data was written with
+    //!   \param[in] pass = pass number the data was written with
+    //!   \param[in] firstLBA = LBA of the first sector in the buffer
+    //!   \param[in] sectorSize = size of each sector in bytes. Must be larger than TAGGED_SECTOR_HEADER_SIZE.
+    //!   \param[in] ptrData = pointer to the data buffer to check
+    //!   \param[in] dataLength = size of the data buffer in bytes. Must be a multiple of sectorSize.
+    //!   \param[in,out] result = optional status array to fill in, and receives the totals
+    //!
+    //  Exit:
+    //!   \return SUCCESS = every sector is good. FAILURE = one or more sectors are not. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int verify_Tagged_Sector_Pattern_In_Buffer(uint64_t seed, uint32_t pass, uint64_t firstLBA, uint32_t sectorSize, const uint8_t *ptrData, size_t dataLength, ptrTaggedSectorVerifyResult result);
+
+    //Entropy pattern fills are made of blocks the size a compressing or deduplicating controller works on. Each block starts with random data
+    //and repeats it to the end of the block, so a compressor shrinks it by the requested ratio. Blocks are repeated within each group of
+    //ENTROPY_PATTERN_DEDUP_WINDOW blocks for the requested dedup ratio, spread across the group rather than next to each other.
+    #define ENTROPY_PATTERN_DEFAULT_BLOCK_SIZE 4096
+    #define ENTROPY_PATTERN_MAX_BLOCK_SIZE (32 * 1024) //repeats must be within a compressor's window (32KiB for deflate) to be found
+    #define ENTROPY_PATTERN_DEDUP_WINDOW 256
+
+    typedef struct _entropyPatternSettings
+    {
+        uint64_t seed;
+        uint32_t blockSize;//size of the blocks that are compressed and deduplicated. 0 = ENTROPY_PATTERN_DEFAULT_BLOCK_SIZE
+        uint32_t compressionRatioPercent;//compressed size of each block as a ratio times 100. Ex: 200 = 2:1. 0 or 100 = incompressible
+        uint32_t dedupRatioPercent;//total blocks / unique blocks times 100. Ex: 300 = 3:1. 0 or 100 = every block is unique
+    }entropyPatternSettings;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Entropy_Pattern_In_Buffer()
+    //
+    //! \brief   Description:  Fills a buffer with data that compresses and deduplicates by the requested ratios, for realistic throughput on SSDs that do either.
+    //!                        Every block is made from the seed and its position alone, so the data for any offset can be made on its own and
+    //!                        filling in pieces gives the same data as one call. Random data comes from fill_Seekable_Random_Pattern_In_Buffer
+    //!                        and the repeats are copies, so the fill gets faster as the compression ratio goes up.
+    //!                        The ratios are exact for whole blocks and whole dedup groups, within rounding to a byte and a block.
+    //
+    //  Entry:
+    //!   \param[in] settings = seed, block size, and ratios
+    //!   \param[in] streamOffset = byte offset of the first byte of the buffer. Ex: LBA * logical sector size.
+    //!   \param[out] ptrData = pointer to the data buffer to fill
+    //!   \param[in] dataLength = size of the data buffer in bytes. Any length is allowed.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = successfully filled buffer. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int fill_Entropy_Pattern_In_Buffer(const entropyPatternSettings *settings, uint64_t streamOffset, uint8_t *ptrData, size_t dataLength);
+
+    typedef struct _sectorRun
+    {
+        uint64_t firstSector;
+        uint64_t sectorCount;
+        bool zero;//true = every byte of these sectors is zero
+    }sectorRun;
+
+    typedef struct _zeroScanResult
+    {
+        //set by the caller
+        uint32_t sectorSize;//0 = PATTERN_VERIFY_DEFAULT_SECTOR_SIZE
+        uint64_t firstSector;//number of the first sector in the buffer, such as its LBA, used for the runs
+        sectorRun *runs;//optional. Receives the zero and nonzero runs in order, alternating between the two.
+        size_t runCapacity;//number of entries in runs
+        //set by the scan
+        size_t runCount;//number of runs found. Can be more than runCapacity, in which case only the first runCapacity were stored.
+        uint64_t zeroSectors;
+        uint64_t nonzeroSectors;
+        uint64_t firstNonzeroOffset;//offset in the buffer of the first byte that is not zero. Only valid when nonzeroSectors is not 0
+    }zeroScanResult, *ptrZeroScanResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  scan_Zero_Sectors()
+    //
+    //! \brief   Description:  Splits a buffer into runs of sectors that are all zeros and sectors that have data, such as to check a sanitize or erase.
+    //!                        Zero runs are found with find_First_Nonzero_Byte across the whole run, and each sector with data is only read until its first nonzero byte.
+    //!                        A partial sector at the end of the buffer counts as a sector.
+    //
+    //  Entry:
+    //!   \param[in] ptrData = pointer to the data buffer to check
+    //!   \param[in] dataLength = size of the data buffer in bytes
+    //!   \param[in,out] result = sector size, first sector number, and optional run list to fill in, and receives the totals
+    //!
+    //  Exit:
+    //!   \return SUCCESS = every sector is zero. FAILURE = one or more sectors are not. BAD_PARAMETER = error in function parameters
+    //
+    //-----------------------------------------------------------------------------
+    int scan_Zero_Sectors(const uint8_t *ptrData, size_t dataLength, ptrZeroScanResult result);
+
+    #define ZERO_MAP_DEFAULT_REGION_SIZE 4096
+
+    typedef struct _dataExtent
+    {
+        uint64_t offset;
+        uint64_t length;
+    }dataExtent;
+
+    typedef struct _zeroRegionMap
+    {
+        //set by the caller
+        uint32_t regionSize;//size of the regions the data is split into. 0 = ZERO_MAP_DEFAULT_REGION_SIZE
+        uint8_t *bitmap;//optional. Bit (N % 8) of byte (N / 8) is set when region N has a byte that is not zero. Cleared when the scan starts.
+        size_t bitmapSize;//size of bitmap in bytes. Regions past the end of the bitmap are still counted and put in the extents.
+        dataExtent *extents;//optional. Receives the byte ranges that are not zero, in order, made of whole regions (the last one can be cut short by the end of the data).
+        size_t extentCapacity;//number of entries in extents
+        //set by the scan
+        size_t extentCount;//number of extents found. Can be more than extentCapacity, in which case only the first extentCapacity were stored.
+        uint64_t nonzeroRegions;
+        uint64_t firstNonzeroOffset;//offset of the first byte that is not zero. Only valid when nonzeroRegions is not 0
+    }zeroRegionMap, *ptrZeroRegionMap;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  map_Nonzero_Regions()
+    //
+    //! \brief   Description:  Finds the regions of a large buffer that are not all zeros, such as when checking that a drive reads back as zero after a sanitize.
+    //!                        The buffer is split between worker threads, and each region is checked with find_First_Nonzero_Byte, which stops at the first byte of data.
+    //
+    //  Entry:
+    //!   \param[in] ptrData = pointer to the data buffer to check
+    //!   \param[in] dataLength = size of the data buffer in bytes
+    //!   \param[in] threadCount = most threads to use, including the calling thread. 0 = one per processor. Small buffers use fewer threads.
+    //!   \param[in,out] map = region size and optional bitmap and extent list to fill in, and receives the totals
+    //!
+    //  Exit:
+    //!   \return SUCCESS = every region is zero. FAILURE = one or more regions are not. BAD_PARAMETER = error in function parameters
+    //!           MEMORY_FAILURE = could not allocate a bitmap for building the extent list
+    //
+    //-----------------------------------------------------------------------------
+    int map_Nonzero_Regions(const uint8_t *ptrData, size_t dataLength, uint32_t threadCount, ptrZeroRegionMap map);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  map_Nonzero_Regions_In_File()
+    //
+    //! \brief   Description:  Same as map_Nonzero_Regions on the whole contents of a file, which is memory mapped with os_Map_File instead of read into a buffer.
+    //!                        Offsets are from the start of the file.
+    //
+    //  Entry:
+    //!   \param[in] filePtr = file to check, opened for reading
+    //!   \param[in] threadCount = most threads to use, including the calling thread. 0 = one per processor.
+    //!   \param[in,out] map = region size and optional bitmap and extent list to fill in, and receives the totals
+    //!
+    //  Exit:
+    //!   \return SUCCESS = every region is zero. FAILURE = one or more regions are not, or the file could not be mapped. BAD_PARAMETER = error in function parameters
+    //!           NOT_SUPPORTED = the file is too large to map. MEMORY_FAILURE = could not allocate a bitmap for building the extent list
+    //
+    //-----------------------------------------------------------------------------
+    int map_Nonzero_Regions_In_File(FILE *filePtr, uint32_t threadCount, ptrZeroRegionMap map);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
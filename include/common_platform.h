@@ -94,6 +94,120 @@ extern "C"
         DEFAULT,//this means white on windows
     }eConsoleColors;
 
+    //The color escape and styled text functions below are the same for every OS and are implemented in common.c. Only the final write is OS specific.
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Console_Color_Escape()
+    //
+    //! \brief   Description:  Gets the ANSI escape sequence that set_Console_Colors uses on 'nix for a color. This is a constant string, so nothing is written or allocated.
+    //
+    //  Entry:
+    //!   \param[in] foregroundBackground - true = foreground, false = background
+    //!   \param[in] consoleColor = one of the eConsoleColors values. Anything invalid gets the sequence for DEFAULT.
+    //!
+    //  Exit:
+    //!   \return pointer to the NULL terminated escape sequence
+    //
+    //-----------------------------------------------------------------------------
+    const char* get_Console_Color_Escape(bool foregroundBackground, eConsoleColors consoleColor);
+
+    //Collects colored text so that a whole table or screen can be written at once instead of with a printf for every color change.
+    //Colors are stored as ANSI escape sequences in the text. They are only added when useColors is true,
+    //which init_Styled_Text sets when the output is a terminal, so redirected output gets plain text.
+    #define STYLED_TEXT_DEFAULT_SIZE 4096 //initial buffer size. The buffer doubles as needed and is kept between writes.
+
+    typedef struct _styledText
+    {
+        char *text;//NULL terminated
+        size_t length;//bytes in text, not counting the NULL terminator
+        size_t size;//bytes allocated for text
+        FILE *outputFile;//where write_Styled_Text writes
+        bool useColors;//true = color changes are added to the text. Can be changed after init_Styled_Text to force colors on or off.
+        bool colorSet;//a color other than DEFAULT is in effect at the end of the text
+    }styledText, *ptrStyledText;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  init_Styled_Text()
+    //
+    //! \brief   Description:  Sets up a styled text buffer for an output file. Colors are turned on only if the output file is a terminal (console on Windows).
+    //
+    //  Entry:
+    //!   \param[out] styled = styled text buffer to set up. Must be freed with free_Styled_Text.
+    //!   \param[in] outputFile = where write_Styled_Text will write. NULL = stdout.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = ready to use, BAD_PARAMETER = styled is NULL, MEMORY_FAILURE = could not allocate the buffer
+    //
+    //-----------------------------------------------------------------------------
+    int init_Styled_Text(ptrStyledText styled, FILE *outputFile);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  append_Styled_Text()
+    //
+    //! \brief   Description:  Formats text with printf rules and adds it to the end of the buffer in the current color.
+    //
+    //  Entry:
+    //!   \param[in,out] styled = styled text buffer set up by init_Styled_Text
+    //!   \param[in] format = printf format string
+    //!   \param[in] ... = arguments for the format string
+    //!
+    //  Exit:
+    //!   \return SUCCESS = text added, BAD_PARAMETER = invalid input or formatting error, MEMORY_FAILURE = could not grow the buffer
+    //
+    //-----------------------------------------------------------------------------
+    int append_Styled_Text(ptrStyledText styled, const char *format, ...);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  set_Styled_Text_Color()
+    //
+    //! \brief   Description:  Changes the color of text appended after this. Works the same as set_Console_Colors, but only adds to the buffer.
+    //!                        Nothing is added when useColors is false.
+    //
+    //  Entry:
+    //!   \param[in,out] styled = styled text buffer set up by init_Styled_Text
+    //!   \param[in] foregroundBackground - true = foreground, false = background
+    //!   \param[in] consoleColor = one of the eConsoleColors values
+    //!
+    //  Exit:
+    //!   \return SUCCESS = color set, BAD_PARAMETER = styled is NULL, MEMORY_FAILURE = could not grow the buffer
+    //
+    //-----------------------------------------------------------------------------
+    int set_Styled_Text_Color(ptrStyledText styled, bool foregroundBackground, eConsoleColors consoleColor);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  write_Styled_Text()
+    //
+    //! \brief   Description:  Writes everything in the buffer to the output file with os_Write_Styled_Text, then empties it so it can be reused for the next redraw.
+    //!                        If a color is still set at the end of the text, the colors are put back to DEFAULT first so they do not leak into later output.
+    //
+    //  Entry:
+    //!   \param[in,out] styled = styled text buffer set up by init_Styled_Text
+    //!
+    //  Exit:
+    //!   \return SUCCESS = written, BAD_PARAMETER = styled is NULL, MEMORY_FAILURE = could not add the color reset, FAILURE = error writing the output
+    //
+    //-----------------------------------------------------------------------------
+    int write_Styled_Text(ptrStyledText styled);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Styled_Text()
+    //
+    //! \brief   Description:  Frees the buffer of a styled text. Anything not written yet is thrown away.
+    //
+    //  Entry:
+    //!   \param[in,out] styled = styled text buffer set up by init_Styled_Text
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void free_Styled_Text(ptrStyledText styled);
+
     ////////////////////////////////////////////////////////////////////////////////////////////
     //// Functions below have specific implementations for OS's in the files included above ////
     ////////////////////////////////////////////////////////////////////////////////////////////
@@ -118,6 +232,42 @@ extern "C"
     //-----------------------------------------------------------------------------
     void set_Console_Colors(bool foregroundBackground, eConsoleColors consoleColor);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  os_Is_Console_Output()
+    //
+    //! \brief   Description:  Checks if a file is a terminal (console on Windows) that can show colors, rather than a file or pipe the output was redirected to.
+    //
+    //  Entry:
+    //!   \param[in] outputFile = file to check
+    //!
+    //  Exit:
+    //!   \return true = terminal, false = not a terminal or outputFile is NULL
+    //
+    //-----------------------------------------------------------------------------
+    bool os_Is_Console_Output(FILE *outputFile);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  os_Write_Styled_Text()
+    //
+    //! \brief   Description:  Writes text containing the color escape sequences from get_Console_Color_Escape. The file is flushed first so earlier stdio output stays in order.
+    //!                        On 'nix the text is written with a single write call (more only if the write is partial).
+    //!                        On Windows the text is written with a single WriteFile when the console accepts escape sequences,
+    //!                        otherwise each color change is done with SetConsoleTextAttribute between writes of the text.
+    //!                        Output redirected away from the console is written with fwrite so the CRT's text mode line ending translation still happens.
+    //
+    //  Entry:
+    //!   \param[in] outputFile = file to write to
+    //!   \param[in] text = text to write. Does not need to be NULL terminated.
+    //!   \param[in] length = number of bytes of text to write
+    //!
+    //  Exit:
+    //!   \return SUCCESS = everything written, BAD_PARAMETER = invalid input, FAILURE = error writing the output
+    //
+    //-----------------------------------------------------------------------------
+    int os_Write_Styled_Text(FILE *outputFile, const char *text, size_t length);
+
     //-----------------------------------------------------------------------------
     //
     // bool os_Directory_Exits (const char * const pathToCheck)
@@ -434,6 +584,49 @@ extern "C"
     //-----------------------------------------------------------------------------
     int64_t os_Get_File_Size(FILE *filePtr);
 
+    typedef struct _seaFileMapping
+    {
+        const uint8_t *data;//contents of the file. NULL when the file is empty.
+        uint64_t length;//size of the file in bytes
+        void *osMappingHandle;//OS specific handle. Do not use directly.
+    }seaFileMapping;
+
+    //-----------------------------------------------------------------------------
+    //
+    // int os_Map_File(FILE *filePtr, seaFileMapping *mapping)
+    //
+    // \brief   Description: Maps a whole file into memory read only, so it can be scanned like a buffer (including from several threads) without reading it in first.
+    //                       Pages are read from the file as they are touched. Uses mmap in nix systems and CreateFileMapping/MapViewOfFile in Windows.
+    //
+    // Entry:
+    //      \param[in] filePtr - file to map. It must be opened for reading and should not change size while it is mapped.
+    //      \param[out] mapping - receives the mapped data and its length. Pass to os_Unmap_File when done.
+    //
+    // Exit:
+    //      \return SUCCESS = file mapped (an empty file gives NULL data), BAD_PARAMETER = invalid input,
+    //              NOT_SUPPORTED = the file is too large for the address space, FAILURE = the OS could not map the file
+    //
+    //-----------------------------------------------------------------------------
+    int os_Map_File(FILE *filePtr, seaFileMapping *mapping);
+
+    //-----------------------------------------------------------------------------
+    //
+    // int os_Unmap_File(seaFileMapping *mapping)
+    //
+    // \brief   Description: Releases a mapping made by os_Map_File. The mapping is cleared.
+    //
+    // Entry:
+    //      \param[in,out] mapping - mapping to release
+    //
+    // Exit:
+    //      \return SUCCESS = mapping released, BAD_PARAMETER = invalid input, FAILURE = the OS could not release it
+    //
+    //-----------------------------------------------------------------------------
+    int os_Unmap_File(seaFileMapping *mapping);
+
+    //Timer values are in OS or CPU specific units: QueryPerformanceCounter counts in Windows. In nix systems they are TSC or aarch64 counter ticks when
+    //that counter runs at a constant rate (checked and calibrated against CLOCK_MONOTONIC on first use), otherwise CLOCK_MONOTONIC nanoseconds.
+    //The units never change while a program runs, so values from different timers can be mixed. Use get_Nano_Seconds and friends to convert them.
     typedef struct _seatimer_t
     {
         uint64_t timerStart;//system specific count value. May need to do a calculation with this value so using it directly doesn't make sense.
@@ -530,6 +723,121 @@ extern "C"
     //-----------------------------------------------------------------------------
     double get_Seconds(seatimer_t timer);
 
+    typedef void (*seathreadfunc_t)(void *threadData);
+
+    typedef struct _seathread_t
+    {
+        osThreadHandle threadHandle;//OS specific handle. Do not use directly.
+        seathreadfunc_t threadFunction;
+        void *threadData;
+    }seathread_t;
+
+    //-----------------------------------------------------------------------------
+    //
+    // int os_Create_Thread(seathread_t *thread, seathreadfunc_t threadFunction, void *threadData)
+    //
+    // \brief   Description: Starts a new thread running threadFunction(threadData). The seathread_t structure is used by the new thread, so it must stay valid until os_Join_Thread is called.
+    //
+    // Entry:
+    //      \param[out] thread - pointer to a seathread_t structure that will hold the thread information
+    //      \param[in] threadFunction - function for the thread to run
+    //      \param[in] threadData - parameter passed to threadFunction. Can be NULL.
+    //
+    // Exit:
+    //      \return SUCCESS = thread started, BAD_PARAMETER = invalid input, FAILURE = the OS could not start the thread
+    //
+    //-----------------------------------------------------------------------------
+    int os_Create_Thread(seathread_t *thread, seathreadfunc_t threadFunction, void *threadData);
+
+    //-----------------------------------------------------------------------------
+    //
+    // int os_Join_Thread(seathread_t *thread)
+    //
+    // \brief   Description: Waits for a thread started with os_Create_Thread to finish and releases the OS resources for it.
+    //
+    // Entry:
+    //      \param[in] thread - pointer to a seathread_t structure that was passed to os_Create_Thread
+    //
+    // Exit:
+    //      \return SUCCESS = thread finished, FAILURE = unable to wait for the thread
+    //
+    //-----------------------------------------------------------------------------
+    int os_Join_Thread(seathread_t *thread);
+
+    //-----------------------------------------------------------------------------
+    //
+    // uint32_t os_Get_Processor_Count(void)
+    //
+    // \brief   Description: Gets the number of processors that are currently online. Useful for deciding how many worker threads to start.
+    //
+    // Entry:
+    //
+    // Exit:
+    //      \return number of online processors. 1 is returned if this cannot be determined.
+    //
+    //-----------------------------------------------------------------------------
+    uint32_t os_Get_Processor_Count(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    // void os_Yield_Thread(void)
+    //
+    // \brief   Description: Gives the rest of the calling thread's time slice to another thread that is ready to run. Use this while waiting on a flag set by another thread.
+    //
+    // Entry:
+    //
+    // Exit:
+    //      \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void os_Yield_Thread(void);
+
+    //common.h includes this file before it defines these, so the raw output functions below use the struct names
+    struct _OutputInfo;
+    struct _tDataPtr;
+
+    //-----------------------------------------------------------------------------
+    //
+    // int os_Write_Raw_Output(OutputInfo *outputInfo, const tDataPtr *dataList, uint32_t dataCount, bool zeroCopy)
+    //
+    // \brief   Description: Writes a list of raw binary buffers for SEAC_OUTPUT_RAW. The buffers are written in order to the descriptor under outputInfo->outputFilePtr
+    //                       with writev (nix) or WriteFile (Windows) so that nothing is copied through stdio buffers or changed by text mode newline translation.
+    //                       The file pointer is flushed first so earlier stdio output stays in order.
+    //                       On Linux, when the output is a pipe and zeroCopy is true, vmsplice is used to hand the buffer pages to the pipe instead of copying them.
+    //
+    // Entry:
+    //      \param[in] outputInfo - output to write to. outputFormat must be SEAC_OUTPUT_RAW. If outputFilePtr is NULL, stdout is used.
+    //      \param[in] dataList - list of buffers to write. Only pData and DataLen are used.
+    //      \param[in] dataCount - number of entries in dataList
+    //      \param[in] zeroCopy - set to true only when the buffers will not be changed or freed until the reader has consumed them.
+    //                            With vmsplice the pipe holds references to the buffer pages, so changing them early changes what the reader receives.
+    //
+    // Exit:
+    //      \return SUCCESS = everything written, BAD_PARAMETER = invalid input, NOT_SUPPORTED = outputFormat is not SEAC_OUTPUT_RAW, FAILURE = error writing the output
+    //
+    //-----------------------------------------------------------------------------
+    int os_Write_Raw_Output(struct _OutputInfo *outputInfo, const struct _tDataPtr *dataList, uint32_t dataCount, bool zeroCopy);
+
+    //-----------------------------------------------------------------------------
+    //
+    // int os_Write_Raw_File_Output(OutputInfo *outputInfo, FILE *inputFile, uint64_t length)
+    //
+    // \brief   Description: Writes length bytes from the current position of inputFile for SEAC_OUTPUT_RAW, such as a saved log being sent to a compressor.
+    //                       On Linux, when the output is a pipe and the input is seekable, splice is used so that the data is moved inside the kernel without being copied to user space.
+    //                       Otherwise the data is copied through a single buffer. The position of inputFile is moved past the data that was written.
+    //
+    // Entry:
+    //      \param[in] outputInfo - output to write to. outputFormat must be SEAC_OUTPUT_RAW. If outputFilePtr is NULL, stdout is used.
+    //      \param[in] inputFile - file to read the data from, starting at its current position
+    //      \param[in] length - number of bytes to write
+    //
+    // Exit:
+    //      \return SUCCESS = everything written, BAD_PARAMETER = invalid input, NOT_SUPPORTED = outputFormat is not SEAC_OUTPUT_RAW,
+    //              MEMORY_FAILURE = could not allocate the copy buffer, FAILURE = error reading the input (including ending early) or writing the output
+    //
+    //-----------------------------------------------------------------------------
+    int os_Write_Raw_File_Output(struct _OutputInfo *outputInfo, FILE *inputFile, uint64_t length);
+
 #if defined (__cplusplus)
 } //extern "C"
 #endif
@@ -0,0 +1,148 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_profile.h
+// \brief Defines profiling zones that record where time is spent, and writes them as a Chrome trace for chrome://tracing or Perfetto
+//
+#pragma once
+
+#include "common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //Mark zones with the macros below. They only do something when the code using them is built with OPENSEA_PROFILING defined,
+    //otherwise they compile to nothing. Zones nest: every PROFILE_ZONE_BEGIN needs a PROFILE_ZONE_END on the same thread before the zone it is in ends.
+    //Ex:
+    //  PROFILE_FUNCTION_BEGIN();
+    //  PROFILE_ZONE_BEGIN("read sectors");
+    //  ...
+    //  PROFILE_ZONE_END();
+    //  PROFILE_FUNCTION_END();
+    #if defined (OPENSEA_PROFILING) //THIS FLAG IS NOT ENABLED BY DEFAULT
+        #define PROFILE_ZONE_BEGIN(name) profile_Zone_Begin(name)
+        #define PROFILE_ZONE_END() profile_Zone_End()
+        #define PROFILE_FUNCTION_BEGIN() profile_Zone_Begin(__FUNCTION__)
+        #define PROFILE_FUNCTION_END() profile_Zone_End()
+    #else
+        #define PROFILE_ZONE_BEGIN(name) ((void)0)
+        #define PROFILE_ZONE_END() ((void)0)
+        #define PROFILE_FUNCTION_BEGIN() ((void)0)
+        #define PROFILE_FUNCTION_END() ((void)0)
+    #endif
+
+    #define PROFILE_DEFAULT_EVENTS_PER_THREAD (64 * 1024) //each zone uses 2 events
+
+    typedef struct _profileConfig
+    {
+        uint32_t eventsPerThread;//size of each thread's buffer. When it fills up, new zones on that thread are dropped. 0 = PROFILE_DEFAULT_EVENTS_PER_THREAD
+    }profileConfig, *ptrProfileConfig;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  start_Profiling()
+    //
+    //! \brief   Description:  Starts recording zones. Until this is called, zones are ignored. Each thread that records gets its own buffer
+    //!                        the first time it begins a zone, so recording needs no locks.
+    //
+    //  Entry:
+    //!   \param[in] config = settings for the buffers. Can be NULL to use the defaults.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = recording. FAILURE = already started
+    //
+    //-----------------------------------------------------------------------------
+    int start_Profiling(ptrProfileConfig config);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  stop_Profiling()
+    //
+    //! \brief   Description:  Stops recording and frees every thread's buffer. Call write_Profile_Trace first to keep what was recorded.
+    //!                        Other threads must not be in profile_Zone_Begin or profile_Zone_End when this is called.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return SUCCESS = stopped. FAILURE = not started
+    //
+    //-----------------------------------------------------------------------------
+    int stop_Profiling(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  profile_Zone_Begin() / profile_Zone_End()
+    //
+    //! \brief   Description:  Records the start or end of a zone on the calling thread, timestamped with the seatimer_t clock.
+    //!                        Use the PROFILE_ macros instead so the calls can be compiled out.
+    //!                        When a thread's buffer is nearly full, new zones are dropped whole, so the zones that are kept always have an end.
+    //
+    //  Entry:
+    //!   \param[in] name = name of the zone. Only the pointer is saved, so use a string literal (like __FUNCTION__).
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void profile_Zone_Begin(const char *name);
+    void profile_Zone_End(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  release_Profile_Thread_Buffer()
+    //
+    //! \brief   Description:  Lets another thread reuse this thread's buffer. Call this, with no zones open, before a thread that has profiled exits.
+    //!                        Otherwise its buffer is kept until stop_Profiling. Events already recorded are kept and show up under the same thread id as the next user's.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return VOID
+    //
+    //-----------------------------------------------------------------------------
+    void release_Profile_Thread_Buffer(void);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  write_Profile_Trace()
+    //
+    //! \brief   Description:  Writes all the recorded zones in the Chrome trace event JSON format, which chrome://tracing and https://ui.perfetto.dev can open.
+    //!                        Can be called while other threads are still recording. Zones that have not ended yet are written without an end.
+    //
+    //  Entry:
+    //!   \param[in] traceFile = file to write the trace to
+    //!
+    //  Exit:
+    //!   \return SUCCESS = trace written. BAD_PARAMETER = error in function parameters. FAILURE = not started.
+    //!           MEMORY_FAILURE or another error code from writing the file
+    //
+    //-----------------------------------------------------------------------------
+    int write_Profile_Trace(FILE *traceFile);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Profile_Dropped_Count()
+    //
+    //! \brief   Description:  Gets the number of zones thrown away because a thread's buffer was full.
+    //
+    //  Entry:
+    //!
+    //  Exit:
+    //!   \return number of zones dropped since profiling was started
+    //
+    //-----------------------------------------------------------------------------
+    uint64_t get_Profile_Dropped_Count(void);
+
+#if defined (__cplusplus)
+} //extern "C"
+#endif
@@ -32,6 +32,8 @@ extern "C"
     #define SYSTEM_PATH_SEPARATOR '\\'
     #define SYSTEM_PATH_SEPARATOR_STR "\\"
 
+    typedef HANDLE osThreadHandle;
+
     //  
     // _WIN32_WINNT version constants  
     //  
@@ -13,10 +13,13 @@
 // \brief Implements functions that are common to OS & Non-OS code.
 //
 #include "common.h"
+#include "common_pattern.h"
 #include <ctype.h>
+#include <stdarg.h> //va_list for append_Styled_Text
 
 #if defined (_WIN32)
 #include <windows.h> //used for setting color output to the command prompt and Sleep()
+#include <io.h> //_write for dumping data to a file descriptor
 #else
 #include <unistd.h> //needed for usleep() or nanosleep()
 #include <time.h>
@@ -24,6 +27,27 @@
 #endif
 #include <stdlib.h>//aligned allocation functions come from here
 #include <math.h>
+//SIMD intrinsics used by the buffer compare functions. These are the baseline instruction sets for x86_64 and aarch64 so no runtime check is needed
+#if defined (__SSE2__) || defined (_M_X64) || defined (_M_AMD64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPENSEA_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+#define OPENSEA_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#if defined (OPENSEA_CPU_X86)
+#include <immintrin.h> //AVX2 zero check, picked at runtime
+#if defined (_MSC_VER)
+#include <intrin.h> //__cpuidex and _xgetbv
+#else
+#include <cpuid.h>
+#endif
+#elif defined (__linux__) && defined (__aarch64__)
+#include <sys/auxv.h> //getauxval for the CPU features that are not part of the aarch64 baseline
+#if !defined (HWCAP_CRC32)
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#endif
 
 void delay_Milliseconds(uint32_t milliseconds)
 {
@@ -48,6 +72,126 @@ void delay_Seconds(uint32_t seconds)
 {
     delay_Milliseconds(1000 * seconds);
 }
+
+#define CPU_FEATURES_CHECKED BIT63 //set in the saved features once the CPU has been checked
+
+#if defined (OPENSEA_CPU_X86)
+static void read_CPUID(uint32_t leaf, uint32_t subleaf, uint32_t registers[4])
+{
+#if defined (_MSC_VER)
+    int cpuInfo[4] = { 0 };
+    __cpuidex(cpuInfo, (int)leaf, (int)subleaf);
+    registers[0] = (uint32_t)cpuInfo[0];
+    registers[1] = (uint32_t)cpuInfo[1];
+    registers[2] = (uint32_t)cpuInfo[2];
+    registers[3] = (uint32_t)cpuInfo[3];
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+//reads XCR0 to see which register sets the OS saves on a context switch
+static uint64_t read_XCR0(void)
+{
+#if defined (_MSC_VER)
+    return (uint64_t)_xgetbv(0);
+#else
+    uint32_t low = 0, high = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((uint64_t)high << 32) | low;
+#endif
+}
+#endif
+
+static uint64_t detect_CPU_Features(void)
+{
+    uint64_t features = CPU_FEATURES_CHECKED;
+#if defined (OPENSEA_CPU_X86)
+    uint32_t registers[4] = { 0 };
+    uint32_t maxLeaf = 0;
+    read_CPUID(0, 0, registers);
+    maxLeaf = registers[0];
+    if (maxLeaf >= 1)
+    {
+        read_CPUID(1, 0, registers);
+        if (registers[3] & BIT26)
+        {
+            features |= CPU_FEATURE_SSE2;
+        }
+        if (registers[2] & BIT9)
+        {
+            features |= CPU_FEATURE_SSSE3;
+        }
+        if (registers[2] & BIT20)
+        {
+            features |= CPU_FEATURE_SSE4_2;
+        }
+        if (registers[2] & BIT1)
+        {
+            features |= CPU_FEATURE_PCLMULQDQ;
+        }
+        //AVX2 also needs the OS to save the YMM registers, which is only known through XGETBV when OSXSAVE is set
+        if ((registers[2] & BIT27) && (registers[2] & BIT28) && (read_XCR0() & (BIT1 | BIT2)) == (BIT1 | BIT2) && maxLeaf >= 7)
+        {
+            read_CPUID(7, 0, registers);
+            if (registers[1] & BIT5)
+            {
+                features |= CPU_FEATURE_AVX2;
+            }
+        }
+    }
+    read_CPUID(0x80000000, 0, registers);
+    if (registers[0] >= 0x80000007)
+    {
+        read_CPUID(0x80000007, 0, registers);
+        if (registers[3] & BIT8)
+        {
+            features |= CPU_FEATURE_INVARIANT_TSC;
+        }
+    }
+#elif defined (__aarch64__) || defined (_M_ARM64) || defined (__ARM_NEON) || defined (__ARM_NEON__)
+    //NEON is part of the baseline for aarch64. On 32bit ARM this is only set when the build already requires it.
+    features |= CPU_FEATURE_NEON;
+    #if defined (__ARM_FEATURE_CRC32) || (defined (__APPLE__) && defined (__aarch64__))
+    //the build already requires the CRC32 instructions. Every Apple aarch64 CPU has them.
+    features |= CPU_FEATURE_ARM_CRC32;
+    #elif defined (__linux__) && defined (__aarch64__)
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32)
+    {
+        features |= CPU_FEATURE_ARM_CRC32;
+    }
+    #elif defined (_M_ARM64)
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE))
+    {
+        features |= CPU_FEATURE_ARM_CRC32;
+    }
+    #endif
+#endif
+    return features;
+}
+
+uint64_t get_CPU_Features(void)
+{
+    static uint64_t savedFeatures = 0;
+    uint64_t features = 0;
+    //Threads racing on the first call all write the same value, so the only requirement is that the 64bit value is not torn
+#if defined (_MSC_VER)
+    features = (uint64_t)InterlockedCompareExchange64((volatile LONG64*)&savedFeatures, 0, 0);
+    if (features == 0)
+    {
+        features = detect_CPU_Features();
+        InterlockedExchange64((volatile LONG64*)&savedFeatures, (LONG64)features);
+    }
+#else
+    features = __atomic_load_n(&savedFeatures, __ATOMIC_RELAXED);
+    if (features == 0)
+    {
+        features = detect_CPU_Features();
+        __atomic_store_n(&savedFeatures, features, __ATOMIC_RELAXED);
+    }
+#endif
+    return features & ~CPU_FEATURES_CHECKED;
+}
 //TODO: C11 says supported alignments are implementation defined
 //      We may want an if/else to call back to a generic method if it fails some day. (unlikely, so not done right now)
 //      NOTE: There may also be other functions to do this for other compilers or systems, but they are not known today. Add them as necessary
@@ -502,176 +646,862 @@ size_t find_last_occurrence_in_string(char *originalString, char *stringToFind)
     return last_occurrence;
 }
 
+typedef struct _returnValueString
+{
+    const char *name;
+    const char *description;
+}returnValueString;
+
+//Indexed by eReturnValues. Must stay in the same order as the enum.
+static const returnValueString returnValueStrings[] = {
+    { "SUCCESS", "Completed successfully" },
+    { "FAILURE", "The operation failed" },
+    { "NOT SUPPORTED", "Not supported by the device or the software" },
+    { "COMMAND FAILURE", "The device returned an error for the command" },
+    { "IN PROGRESS", "Another command is in progress, or the command is running in the background" },
+    { "ABORTED", "The command was aborted" },
+    { "BAD PARAMETER", "A function was called with an invalid parameter" },
+    { "MEMORY FAILURE", "Could not allocate memory" },
+    { "OS PASSTHROUGH FAILURE", "The OS API call to issue the pass-through command failed" },
+    { "LIBRARY MISMATCH", "Library versions do not match" },
+    { "FROZEN", "The device is frozen for this command" },
+    { "PERMISSION DENIED", "The OS denied access" },
+    { "FILE OPEN ERROR", "Could not open a file" },
+    { "WARNING INCOMPLETE RTFRS", "The command completed, but the full return task file registers were not available" },
+    { "COMMAND TIMEOUT", "The command took longer than the timeout given to the OS" },
+    { "WARNING NOT ALL DEVICES ENUMERATED", "Some devices could not be enumerated" },
+    { "WARN INVALID CHECKSUM", "The checksum of the returned data is not correct" },
+    { "OS COMMAND NOT AVAILABLE", "The OS does not have a way to issue this command" },
+    { "OS COMMAND BLOCKED", "The OS blocked the command from being issued" },
+    { "COMMAND INTERRUPTED", "The command was interrupted by another command" },
+};
+
+//fails to compile when an eReturnValue is added without adding it to the table above
+typedef char returnValueStringsSizeCheck[(sizeof(returnValueStrings) / sizeof(returnValueStrings[0])) == UNKNOWN ? 1 : -1];
+
+const char* get_Return_Enum_Name(int ret)
+{
+    if (ret >= 0 && ret < UNKNOWN)
+    {
+        return returnValueStrings[ret].name;
+    }
+    return "UNKNOWN";
+}
+
+const char* get_Return_Enum_Description(int ret)
+{
+    if (ret >= 0 && ret < UNKNOWN)
+    {
+        return returnValueStrings[ret].description;
+    }
+    return "UNKNOWN";
+}
+
+size_t format_Return_Enum(const char *funcName, int ret, bool includeDescription, char *buffer, size_t bufferSize)
+{
+    int length = 0;
+    char emptyBuffer[1];
+    if (!buffer || bufferSize == 0)
+    {
+        //still report the length so that callers can size a buffer
+        buffer = emptyBuffer;
+        bufferSize = 1;
+    }
+    if (ret >= 0 && ret < UNKNOWN)
+    {
+        length = snprintf(buffer, bufferSize, "%s returning: %s%s%s", funcName ? funcName : "Unknown funtion", returnValueStrings[ret].name, includeDescription ? " - " : "", includeDescription ? returnValueStrings[ret].description : "");
+    }
+    else
+    {
+        length = snprintf(buffer, bufferSize, "%s returning: UNKNOWN: %d", funcName ? funcName : "Unknown funtion", ret);
+    }
+    buffer[bufferSize - 1] = '\0';//older Microsoft _snprintf does not terminate when it truncates
+    return length < 0 ? 0 : (size_t)length;
+}
+
 void print_Return_Enum(char *funcName, int ret)
 {
-    if (NULL == funcName)
+    if (ret >= 0 && ret < UNKNOWN)
     {
-        printf("Unknown funtion returning: ");
+        printf("%s returning: %s\n\n", funcName ? funcName : "Unknown funtion", returnValueStrings[ret].name);
     }
     else
     {
-        printf("%s returning: ", funcName);
+        printf("%s returning: UNKNOWN: %d\n\n", funcName ? funcName : "Unknown funtion", ret);
     }
+}
+
+static OPENSEA_THREAD_LOCAL errorHistoryEntry errorHistory[ERROR_HISTORY_DEPTH];
+static OPENSEA_THREAD_LOCAL uint32_t errorHistoryCount;//total errors recorded. The newest is at (errorHistoryCount - 1) % ERROR_HISTORY_DEPTH
 
-    switch (ret)
+void record_Error(int returnValue, const char *functionName)
+{
+    seatimer_t timestamp;
+    errorHistoryEntry *entry = &errorHistory[errorHistoryCount & (ERROR_HISTORY_DEPTH - 1)];
+    start_Timer(&timestamp);
+    entry->returnValue = returnValue;
+    entry->functionName = functionName;
+    entry->timestamp = timestamp.timerStart;
+    ++errorHistoryCount;
+}
+
+uint32_t get_Error_History(ptrErrorHistoryEntry entries, uint32_t maxEntries)
+{
+    uint32_t copied = 0;
+    uint32_t available = M_Min(errorHistoryCount, ERROR_HISTORY_DEPTH);
+    if (!entries)
     {
-    case SUCCESS:
-        printf("SUCCESS\n");
-        break;
-    case FAILURE:
-        printf("FAILURE\n");
-        break;
-    case NOT_SUPPORTED:
-        printf("NOT SUPPORTED\n");
-        break;
-    case COMMAND_FAILURE:
-        printf("COMMAND FAILURE\n");
-        break;
-    case IN_PROGRESS:
-        printf("IN PROGRESS\n");
-        break;
-    case ABORTED:
-        printf("ABORTED\n");
-        break;
-    case BAD_PARAMETER:
-        printf("BAD PARAMETER\n");
-        break;
-    case MEMORY_FAILURE:
-        printf("MEMORY FAILURE\n");
-        break;
-    case OS_PASSTHROUGH_FAILURE:
-        printf("OS PASSTHROUGH FAILURE\n");
-        break;
-    case LIBRARY_MISMATCH:
-        printf("LIBRARY MISMATCH\n");
-        break;
-    case FROZEN:
-        printf("FROZEN\n");
-        break;
-    case PERMISSION_DENIED:
-        printf("PERMISSION DENIED\n");
-        break;
-    case FILE_OPEN_ERROR:
-        printf("FILE OPEN ERROR\n");
-        break;
-    case WARN_INCOMPLETE_RFTRS:
-        printf("WARNING INCOMPLETE RTFRS\n");
-        break;
-    case COMMAND_TIMEOUT:
-        printf("COMMAND TIMEOUT\n");
-        break;
-    case WARN_NOT_ALL_DEVICES_ENUMERATED:
-        printf("WARNING NOT ALL DEVICES ENUMERATED\n");
-        break;
-    case WARN_INVALID_CHECKSUM:
-        printf("WARN INVALID CHECKSUM\n");
-        break;
-    case OS_COMMAND_NOT_AVAILABLE:
-        printf("OS COMMAND NOT AVAILABLE\n");
-        break;
-    case OS_COMMAND_BLOCKED:
-        printf("OS COMMAND BLOCKED\n");
-        break;
-    default:
-        printf("UNKNOWN: %d\n", ret);
-        break;
+        return 0;
+    }
+    for (; copied < available && copied < maxEntries; ++copied)
+    {
+        entries[copied] = errorHistory[(errorHistoryCount - 1 - copied) & (ERROR_HISTORY_DEPTH - 1)];
     }
-    printf("\n");
+    return copied;
 }
 
-void print_Data_Buffer(uint8_t *dataBuffer, uint32_t bufferLen, bool showPrint)
+void clear_Error_History(void)
+{
+    errorHistoryCount = 0;
+}
+
+void print_Error_History(void)
+{
+    errorHistoryEntry entries[ERROR_HISTORY_DEPTH];
+    uint32_t count = get_Error_History(entries, ERROR_HISTORY_DEPTH);
+    uint32_t iter = 0;
+    seatimer_t age;
+    memset(&age, 0, sizeof(seatimer_t));
+    start_Timer(&age);
+    age.timerStop = age.timerStart;
+    for (iter = 0; iter < count; ++iter)
+    {
+        age.timerStart = entries[iter].timestamp;
+        printf("%s returned %s (%d) %.3f ms ago\n", entries[iter].functionName ? entries[iter].functionName : "Unknown funtion", get_Return_Enum_Name(entries[iter].returnValue), entries[iter].returnValue, get_Milli_Seconds(age));
+    }
+}
+
+#define DATA_DUMP_BYTES_PER_LINE 16
+#define DATA_DUMP_MAX_LINE_CHARS 88 //"\n  0x" + 16 offset digits + " " + 16 * "XX " + "  " + 16 printable characters
+#define DATA_DUMP_CHUNK_SIZE (128 * 1024) //how much of the buffer a single thread formats at a time. Must be a multiple of DATA_DUMP_BYTES_PER_LINE
+#define DATA_DUMP_MAX_THREADS 16
+#define DATA_DUMP_YIELD_ATTEMPTS 64 //times a thread yields while waiting for a slot before it starts sleeping
+
+static const char dataDumpHexDigits[] = "0123456789ABCDEF";
+
+//returns a mask with bit N set when byte N of the two 16 byte lines is different. 0 means the lines match
+static uint16_t compare_16_Bytes(const uint8_t *lineA, const uint8_t *lineB)
+{
+#if defined (OPENSEA_SIMD_SSE2)
+    __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)lineA), _mm_loadu_si128((const __m128i*)lineB));
+    return (uint16_t)(~_mm_movemask_epi8(equal) & 0xFFFF);
+#else
+    uint16_t differenceMask = 0;
+    #if defined (OPENSEA_SIMD_NEON)
+    uint64x2_t difference = vreinterpretq_u64_u8(veorq_u8(vld1q_u8(lineA), vld1q_u8(lineB)));
+    if ((vgetq_lane_u64(difference, 0) | vgetq_lane_u64(difference, 1)) == 0)
+    {
+        return 0;
+    }
+    #else
+    uint64_t a[2], b[2];
+    memcpy(a, lineA, sizeof(a));
+    memcpy(b, lineB, sizeof(b));
+    if (a[0] == b[0] && a[1] == b[1])
+    {
+        return 0;
+    }
+    #endif
+    //lines are different, so find out which bytes
+    for (uint8_t iter = 0; iter < 16; ++iter)
+    {
+        if (lineA[iter] != lineB[iter])
+        {
+            differenceMask |= (uint16_t)(1 << iter);
+        }
+    }
+    return differenceMask;
+#endif
+}
+
+//One slot of output text. Chunk N of the buffer is formatted into slot N % slotCount, and the calling thread writes the slots out in order.
+typedef struct _dataDumpChunk
+{
+    uint64_t chunkStart;//offset from the start of dataBuffer
+    uint64_t chunkLength;
+    volatile uint32_t formattedChunk;//chunk number + 1 of the text in this slot. Set once the text is ready to write.
+    volatile uint32_t writtenChunk;//chunk number + 1 of the last text written from this slot. The slot can be reused after this is set.
+    char *text;
+    size_t textLength;
+}dataDumpChunk;
+
+typedef struct _dataDumpJob
 {
-    uint32_t printIter = 0, offset = 0;
-    uint32_t offsetWidth = 2;//used to figure out how wide we need to pad with 0's for consistent output, 2 is the minimum width
-    if (bufferLen <= UINT8_MAX)
+    const uint8_t *dataBuffer;
+    uint64_t bufferLength;
+    ptrDataDumpOptions options;
+    uint8_t offsetWidth;
+    uint32_t chunkCount;
+    uint32_t slotCount;
+    dataDumpChunk *slots;
+    volatile uint32_t nextChunk;//next chunk number for a worker thread to take
+    volatile uint32_t stopped;//set when writing fails so the worker threads stop waiting for slots
+}dataDumpJob;
+
+static uint8_t get_Data_Dump_Offset_Width(uint64_t lastOffset)
+{
+    if (lastOffset <= UINT8_MAX)
+    {
+        return 2;
+    }
+    else if (lastOffset <= UINT16_MAX)
     {
-        offsetWidth = 2;
-        printf("\n        "); //0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F  ");
+        return 4;
     }
-    else if (bufferLen <= UINT16_MAX)
+    else if (lastOffset <= 0xFFFFFF)
     {
-        offsetWidth = 4;
-        printf("\n          "); //0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F  ");
+        return 6;
     }
-    else if (bufferLen <= 0xFFFFFF)
+    else if (lastOffset <= UINT32_MAX)
     {
-        offsetWidth = 6;
-        printf("\n            "); //0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F  ");
+        return 8;
     }
-    else//32bit width, don't care about 64bit since max size if 32bit
+    else
     {
-        offsetWidth = 8;
-        printf("\n              "); //0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F  ");
+        return 16;
     }
-    //we print out 2 (0x) + printf formatting width + 2 (spaces) then the offsets
+}
 
-    for (printIter = 0; printIter < 16 && printIter < bufferLen; printIter++)
+//formats one line of output. Returns the number of characters placed in output, which must be at least DATA_DUMP_MAX_LINE_CHARS long
+static size_t format_Data_Dump_Line(char *output, const uint8_t *lineData, uint32_t lineLength, uint64_t offset, uint8_t offsetWidth, bool showPrint)
+{
+    char *outputPtr = output;
+    *outputPtr++ = '\n';
+    *outputPtr++ = ' ';
+    *outputPtr++ = ' ';
+    *outputPtr++ = '0';
+    *outputPtr++ = 'x';
+    for (int8_t shift = (int8_t)((offsetWidth - 1) * 4); shift >= 0; shift -= 4)
     {
-        printf("%"PRIX32"  ", printIter);
+        *outputPtr++ = dataDumpHexDigits[(offset >> shift) & 0x0F];
     }
-    char lineBuff[18] = { 0 };
-    uint8_t lineBuffIter = 0;
-    for (printIter = 0, offset = 0; printIter < bufferLen; ++printIter, ++lineBuffIter)
+    *outputPtr++ = ' ';
+    for (uint32_t iter = 0; iter < lineLength; ++iter)
     {
-        if (lineBuffIter > sizeof(lineBuff))
+        *outputPtr++ = dataDumpHexDigits[M_Nibble1(lineData[iter])];
+        *outputPtr++ = dataDumpHexDigits[M_Nibble0(lineData[iter])];
+        *outputPtr++ = ' ';
+    }
+    if (showPrint)
+    {
+        //pad a short line so that the printable characters still line up
+        memset(outputPtr, ' ', (DATA_DUMP_BYTES_PER_LINE - lineLength) * 3 + 2);
+        outputPtr += (DATA_DUMP_BYTES_PER_LINE - lineLength) * 3 + 2;
+        for (uint32_t iter = 0; iter < lineLength; ++iter)
         {
-            lineBuffIter = 0;
+            //checking the range directly instead of isprint since the locale may change what is printable
+            if (lineData[iter] >= 0x20 && lineData[iter] < 0x7F)
+            {
+                *outputPtr++ = (char)lineData[iter];
+            }
+            else
+            {
+                *outputPtr++ = '.';
+            }
         }
-        //for every 16 bytes we print, we need to make a newline, then print the offset (hex) before we print the data again
-        if (printIter % 16 == 0)
+    }
+    return (size_t)(outputPtr - output);
+}
+
+//Formats a chunk into its text buffer
+static void format_Data_Dump_Chunk(const dataDumpJob *job, dataDumpChunk *chunk)
+{
+    bool previousLineCollapsed = false;
+    chunk->textLength = 0;
+    if (job->options->collapseRepeatedLines && chunk->chunkStart >= 2 * DATA_DUMP_BYTES_PER_LINE)
+    {
+        //the line before this chunk was collapsed by the previous chunk if it repeated the line before it
+        previousLineCollapsed = 0 == compare_16_Bytes(&job->dataBuffer[chunk->chunkStart - DATA_DUMP_BYTES_PER_LINE], &job->dataBuffer[chunk->chunkStart - 2 * DATA_DUMP_BYTES_PER_LINE]);
+    }
+    for (uint64_t lineStart = chunk->chunkStart; lineStart < chunk->chunkStart + chunk->chunkLength; lineStart += DATA_DUMP_BYTES_PER_LINE)
+    {
+        uint32_t lineLength = (uint32_t)M_Min(DATA_DUMP_BYTES_PER_LINE, chunk->chunkStart + chunk->chunkLength - lineStart);
+        if (job->options->collapseRepeatedLines && lineStart > 0 && lineLength == DATA_DUMP_BYTES_PER_LINE && lineStart + lineLength < job->bufferLength
+            && 0 == compare_16_Bytes(&job->dataBuffer[lineStart], &job->dataBuffer[lineStart - DATA_DUMP_BYTES_PER_LINE]))
         {
-            switch (offsetWidth)
+            //same as the line before it. Only the first line of a run gets a marker. The last line of the buffer is always printed so the end offset is shown.
+            if (!previousLineCollapsed)
+            {
+                chunk->text[chunk->textLength++] = '\n';
+                chunk->text[chunk->textLength++] = '*';
+            }
+            previousLineCollapsed = true;
+            continue;
+        }
+        previousLineCollapsed = false;
+        chunk->textLength += format_Data_Dump_Line(&chunk->text[chunk->textLength], &job->dataBuffer[lineStart], lineLength, job->options->baseOffset + lineStart, job->offsetWidth, job->options->showPrint);
+    }
+}
+
+static int write_Data_Dump_Text(ptrDataDumpOptions options, const char *text, size_t textLength)
+{
+    if (options->outputFile)
+    {
+        if (textLength != fwrite(text, sizeof(char), textLength, options->outputFile))
+        {
+            return FAILURE;
+        }
+        return SUCCESS;
+    }
+    while (textLength > 0)
+    {
+#if defined (_WIN32)
+        int written = _write(options->outputDescriptor, text, (unsigned int)M_Min(textLength, INT32_MAX));
+#else
+        ssize_t written = write(options->outputDescriptor, text, textLength);
+#endif
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return FAILURE;
+        }
+        text += written;
+        textLength -= (size_t)written;
+    }
+    return SUCCESS;
+}
+
+//Waits for another thread to set flag to value. Spins briefly with yields since the other thread is usually close, then sleeps so a slow output does not keep a processor busy.
+static bool wait_For_Data_Dump_Flag(volatile uint32_t *flag, uint32_t value, volatile uint32_t *stopped)
+{
+    uint32_t attempts = 0;
+    while (M_Atomic_Load(flag) != value)
+    {
+        if (stopped && M_Atomic_Load(stopped))
+        {
+            return false;
+        }
+        if (attempts < DATA_DUMP_YIELD_ATTEMPTS)
+        {
+            ++attempts;
+            os_Yield_Thread();
+        }
+        else
+        {
+            delay_Milliseconds(1);
+        }
+    }
+    return true;
+}
+
+//Each worker thread takes the next chunk number until all of them are formatted
+static void data_Dump_Worker(void *jobParam)
+{
+    dataDumpJob *job = (dataDumpJob*)jobParam;
+    uint32_t chunkNumber = 0;
+    while ((chunkNumber = M_Atomic_Increment(&job->nextChunk) - 1) < job->chunkCount)
+    {
+        dataDumpChunk *slot = &job->slots[chunkNumber % job->slotCount];
+        //the text of the slot's previous chunk has to be written before it is replaced
+        if (!wait_For_Data_Dump_Flag(&slot->writtenChunk, chunkNumber >= job->slotCount ? chunkNumber - job->slotCount + 1 : 0, &job->stopped))
+        {
+            return;
+        }
+        slot->chunkStart = (uint64_t)chunkNumber * DATA_DUMP_CHUNK_SIZE;
+        slot->chunkLength = M_Min(DATA_DUMP_CHUNK_SIZE, job->bufferLength - slot->chunkStart);
+        format_Data_Dump_Chunk(job, slot);
+        M_Atomic_Store(&slot->formattedChunk, chunkNumber + 1);
+    }
+}
+
+int dump_Data_Buffer(const uint8_t *dataBuffer, uint64_t bufferLen, ptrDataDumpOptions options)
+{
+    int ret = SUCCESS;
+    uint32_t threadCount = 1, threadsStarted = 0;
+    uint64_t chunkCount = 0;
+    char header[DATA_DUMP_MAX_LINE_CHARS] = { 0 };
+    size_t headerLength = 0;
+    dataDumpJob job;
+    seathread_t *threads = NULL;
+    if (!dataBuffer || !options)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&job, 0, sizeof(dataDumpJob));
+    job.dataBuffer = dataBuffer;
+    job.bufferLength = bufferLen;
+    job.options = options;
+    job.offsetWidth = get_Data_Dump_Offset_Width(options->baseOffset + bufferLen);//used to figure out how wide we need to pad with 0's for consistent output, 2 is the minimum width
+    chunkCount = (bufferLen + DATA_DUMP_CHUNK_SIZE - 1) / DATA_DUMP_CHUNK_SIZE;
+    //Threads are only useful when there is more than one chunk to format. Each thread gets two slots so that it can format the next chunk while its last one is being written.
+    threadCount = options->threadCount > 0 ? options->threadCount : os_Get_Processor_Count();
+    threadCount = (uint32_t)M_Min(M_Min(threadCount, DATA_DUMP_MAX_THREADS), chunkCount);
+    if (threadCount < 2 || chunkCount > UINT32_MAX - DATA_DUMP_MAX_THREADS)
+    {
+        threadCount = 1;
+    }
+    job.slotCount = threadCount > 1 ? threadCount * 2 : 1;
+    //allocate everything before writing anything so a failure does not leave a partial dump
+    job.slots = (dataDumpChunk*)calloc(job.slotCount, sizeof(dataDumpChunk));
+    threads = (seathread_t*)calloc(threadCount, sizeof(seathread_t));
+    if (!job.slots || !threads)
+    {
+        safe_Free(job.slots);
+        safe_Free(threads);
+        return MEMORY_FAILURE;
+    }
+    for (uint32_t iter = 0; iter < job.slotCount; ++iter)
+    {
+        job.slots[iter].text = (char*)malloc((DATA_DUMP_CHUNK_SIZE / DATA_DUMP_BYTES_PER_LINE) * DATA_DUMP_MAX_LINE_CHARS);
+        if (!job.slots[iter].text)
+        {
+            ret = MEMORY_FAILURE;
+        }
+    }
+    if (ret == SUCCESS)
+    {
+        //we print out 2 (0x) + the offset width + 2 (spaces) then the offsets
+        header[headerLength++] = '\n';
+        memset(&header[headerLength], ' ', job.offsetWidth + 6);
+        headerLength += job.offsetWidth + 6;
+        for (uint8_t column = 0; column < DATA_DUMP_BYTES_PER_LINE && column < bufferLen; ++column)
+        {
+            header[headerLength++] = dataDumpHexDigits[column];
+            header[headerLength++] = ' ';
+            header[headerLength++] = ' ';
+        }
+        ret = write_Data_Dump_Text(options, header, headerLength);
+    }
+    if (ret == SUCCESS && threadCount > 1)
+    {
+        job.chunkCount = (uint32_t)chunkCount;
+        for (uint32_t iter = 0; iter < threadCount; ++iter)
+        {
+            if (SUCCESS != os_Create_Thread(&threads[threadsStarted], data_Dump_Worker, &job))
             {
-            case 4:
-                printf("\n  0x%04"PRIX32" ", offset);
-                break;
-            case 6:
-                printf("\n  0x%06"PRIX32" ", offset);
-                break;
-            case 8:
-                printf("\n  0x%08"PRIX32" ", offset);
-                break;
-            case 2:
-            default:
-                printf("\n  0x%02"PRIX32" ", offset);
                 break;
             }
-            offset += 16;
+            ++threadsStarted;
         }
-        printf("%02"PRIX8" ", dataBuffer[printIter]);
-        if (showPrint)
+        if (threadsStarted > 0)
         {
-            if (isprint((int)dataBuffer[printIter]))
+            //write the chunks in order as the workers finish them
+            for (uint32_t chunkNumber = 0; chunkNumber < job.chunkCount && ret == SUCCESS; ++chunkNumber)
             {
-                lineBuff[lineBuffIter] = dataBuffer[printIter];
+                dataDumpChunk *slot = &job.slots[chunkNumber % job.slotCount];
+                wait_For_Data_Dump_Flag(&slot->formattedChunk, chunkNumber + 1, NULL);
+                ret = write_Data_Dump_Text(options, slot->text, slot->textLength);
+                M_Atomic_Store(&slot->writtenChunk, chunkNumber + 1);
             }
-            else
+            if (ret != SUCCESS)
+            {
+                M_Atomic_Store(&job.stopped, 1);
+            }
+            for (uint32_t iter = 0; iter < threadsStarted; ++iter)
+            {
+                os_Join_Thread(&threads[iter]);
+            }
+        }
+    }
+    if (ret == SUCCESS && threadsStarted == 0)
+    {
+        //single threaded, or couldn't get a thread, so do the work here instead
+        for (uint64_t chunkStart = 0; chunkStart < bufferLen && ret == SUCCESS; chunkStart += DATA_DUMP_CHUNK_SIZE)
+        {
+            job.slots[0].chunkStart = chunkStart;
+            job.slots[0].chunkLength = M_Min(DATA_DUMP_CHUNK_SIZE, bufferLen - chunkStart);
+            format_Data_Dump_Chunk(&job, &job.slots[0]);
+            ret = write_Data_Dump_Text(options, job.slots[0].text, job.slots[0].textLength);
+        }
+    }
+    if (ret == SUCCESS)
+    {
+        ret = write_Data_Dump_Text(options, "\n\n", 2);
+    }
+    for (uint32_t iter = 0; iter < job.slotCount; ++iter)
+    {
+        safe_Free(job.slots[iter].text);
+    }
+    safe_Free(job.slots);
+    safe_Free(threads);
+    return ret;
+}
+
+void print_Data_Buffer(uint8_t *dataBuffer, uint32_t bufferLen, bool showPrint)
+{
+    dataDumpOptions dumpOptions;
+    memset(&dumpOptions, 0, sizeof(dataDumpOptions));
+    dumpOptions.outputFile = stdout;
+    dumpOptions.showPrint = showPrint;
+    dump_Data_Buffer(dataBuffer, bufferLen, &dumpOptions);
+}
+
+//ANSI escape sequences for each eConsoleColors value, in enum order. http://tldp.org/HOWTO/Bash-Prompt-HOWTO/x329.html
+static const char *consoleForegroundEscapes[] = {
+    "\033[1;34m",//BLUE
+    "\033[1;32m",//GREEN
+    "\033[1;31m",//RED
+    "\033[0;30m",//BLACK
+    "\033[1;36m",//CYAN
+    "\033[1;35m",//MAGENTA
+    "\033[0;33m",//BROWN
+    "\033[1;33m",//YELLOW
+    "\033[1;37m",//WHITE
+    "\033[0;37m",//GRAY
+    "\033[0;34m",//DARK_BLUE
+    "\033[0;32m",//DARK_GREEN
+    "\033[0;31m",//DARK_RED
+    "\033[0;36m",//TEAL
+    "\033[1;30m",//DARK_GRAY
+    "\033[0;35m",//PURPLE
+    "\033[0m",//DEFAULT
+};
+
+static const char *consoleBackgroundEscapes[] = {
+    "\033[7;1;34m",//BLUE
+    "\033[7;1;32m",//GREEN
+    "\033[7;1;31m",//RED
+    "\033[7;30m",//BLACK
+    "\033[7;1;36m",//CYAN
+    "\033[7;1;35m",//MAGENTA
+    "\033[7;33m",//BROWN
+    "\033[7;1;33m",//YELLOW
+    "\033[7;1;37m",//WHITE
+    "\033[7;37m",//GRAY
+    "\033[7;34m",//DARK_BLUE
+    "\033[7;32m",//DARK_GREEN
+    "\033[7;31m",//DARK_RED
+    "\033[7;36m",//TEAL
+    "\033[7;1;30m",//DARK_GRAY
+    "\033[7;35m",//PURPLE
+    "\033[0m",//DEFAULT
+};
+
+//fails to compile when an eConsoleColors value is added without adding it to the tables above
+typedef char consoleForegroundEscapesSizeCheck[(sizeof(consoleForegroundEscapes) / sizeof(consoleForegroundEscapes[0])) == DEFAULT + 1 ? 1 : -1];
+typedef char consoleBackgroundEscapesSizeCheck[(sizeof(consoleBackgroundEscapes) / sizeof(consoleBackgroundEscapes[0])) == DEFAULT + 1 ? 1 : -1];
+
+const char* get_Console_Color_Escape(bool foregroundBackground, eConsoleColors consoleColor)
+{
+    if ((uint32_t)consoleColor > (uint32_t)DEFAULT)
+    {
+        consoleColor = DEFAULT;
+    }
+    return foregroundBackground ? consoleForegroundEscapes[consoleColor] : consoleBackgroundEscapes[consoleColor];
+}
+
+//makes sure there is room for additionalLength more bytes plus the NULL terminator
+static int reserve_Styled_Text(ptrStyledText styled, size_t additionalLength)
+{
+    size_t newSize = styled->size;
+    char *newText = NULL;
+    if (styled->length + additionalLength < styled->size)
+    {
+        return SUCCESS;
+    }
+    while (styled->length + additionalLength >= newSize)
+    {
+        newSize *= 2;
+    }
+    newText = (char*)realloc(styled->text, newSize);
+    if (!newText)
+    {
+        return MEMORY_FAILURE;
+    }
+    styled->text = newText;
+    styled->size = newSize;
+    return SUCCESS;
+}
+
+int init_Styled_Text(ptrStyledText styled, FILE *outputFile)
+{
+    if (!styled)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(styled, 0, sizeof(styledText));
+    styled->text = (char*)malloc(STYLED_TEXT_DEFAULT_SIZE);
+    if (!styled->text)
+    {
+        return MEMORY_FAILURE;
+    }
+    styled->text[0] = '\0';
+    styled->size = STYLED_TEXT_DEFAULT_SIZE;
+    styled->outputFile = outputFile ? outputFile : stdout;
+    styled->useColors = os_Is_Console_Output(styled->outputFile);
+    return SUCCESS;
+}
+
+int append_Styled_Text(ptrStyledText styled, const char *format, ...)
+{
+    va_list args;
+    int formattedLength = 0;
+    if (!styled || !styled->text || !format)
+    {
+        return BAD_PARAMETER;
+    }
+    va_start(args, format);
+    formattedLength = vsnprintf(&styled->text[styled->length], styled->size - styled->length, format, args);
+    va_end(args);
+    if (formattedLength < 0)
+    {
+        styled->text[styled->length] = '\0';
+        return BAD_PARAMETER;
+    }
+    if ((size_t)formattedLength >= styled->size - styled->length)
+    {
+        //did not fit, so grow the buffer and format it again
+        if (SUCCESS != reserve_Styled_Text(styled, (size_t)formattedLength))
+        {
+            styled->text[styled->length] = '\0';
+            return MEMORY_FAILURE;
+        }
+        va_start(args, format);
+        vsnprintf(&styled->text[styled->length], styled->size - styled->length, format, args);
+        va_end(args);
+    }
+    styled->length += (size_t)formattedLength;
+    return SUCCESS;
+}
+
+int set_Styled_Text_Color(ptrStyledText styled, bool foregroundBackground, eConsoleColors consoleColor)
+{
+    const char *escape = NULL;
+    size_t escapeLength = 0;
+    if (!styled || !styled->text)
+    {
+        return BAD_PARAMETER;
+    }
+    if (!styled->useColors)
+    {
+        return SUCCESS;
+    }
+    escape = get_Console_Color_Escape(foregroundBackground, consoleColor);
+    escapeLength = strlen(escape);
+    if (SUCCESS != reserve_Styled_Text(styled, escapeLength))
+    {
+        return MEMORY_FAILURE;
+    }
+    memcpy(&styled->text[styled->length], escape, escapeLength + 1);
+    styled->length += escapeLength;
+    //DEFAULT resets both the foreground and background
+    styled->colorSet = ((uint32_t)consoleColor < (uint32_t)DEFAULT);
+    return SUCCESS;
+}
+
+int write_Styled_Text(ptrStyledText styled)
+{
+    int ret = SUCCESS;
+    if (!styled || !styled->text)
+    {
+        return BAD_PARAMETER;
+    }
+    if (styled->colorSet)
+    {
+        ret = set_Styled_Text_Color(styled, true, DEFAULT);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+    }
+    if (styled->length > 0)
+    {
+        ret = os_Write_Styled_Text(styled->outputFile, styled->text, styled->length);
+    }
+    styled->length = 0;
+    styled->text[0] = '\0';
+    return ret;
+}
+
+void free_Styled_Text(ptrStyledText styled)
+{
+    if (styled)
+    {
+        safe_Free(styled->text);
+        styled->length = 0;
+        styled->size = 0;
+    }
+}
+
+static uint8_t count_Bits_16(uint16_t value)
+{
+    uint8_t count = 0;
+    for (; value; value &= (uint16_t)(value - 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+#define DATA_COMPARE_WRITE_SIZE (64 * 1024) //write the compare output whenever this much has been collected so large compares do not hold it all in memory
+
+//Appends formatted text for the bytes of a line, charsPerByte characters each, one append per run of bytes that are all highlighted or all not.
+//The last separatorChars characters of a highlighted run are left uncolored so only the bytes themselves stand out.
+static void append_Data_Compare_Runs(ptrStyledText styled, const char *text, uint32_t charsPerByte, uint32_t separatorChars, uint32_t lineLength, uint16_t highlightMask, eConsoleColors highlightColor)
+{
+    uint32_t runStart = 0;
+    if (!styled->useColors)
+    {
+        highlightMask = 0;
+    }
+    while (runStart < lineLength)
+    {
+        bool highlighted = (highlightMask >> runStart) & 1;
+        uint32_t runEnd = runStart + 1;
+        int runChars = 0;
+        while (runEnd < lineLength && (bool)((highlightMask >> runEnd) & 1) == highlighted)
+        {
+            ++runEnd;
+        }
+        runChars = (int)((runEnd - runStart) * charsPerByte);
+        if (highlighted)
+        {
+            set_Styled_Text_Color(styled, true, highlightColor);
+            append_Styled_Text(styled, "%.*s", runChars - (int)separatorChars, &text[runStart * charsPerByte]);
+            set_Styled_Text_Color(styled, true, DEFAULT);
+            if (separatorChars > 0)
             {
-                lineBuff[lineBuffIter] = '.';
+                append_Styled_Text(styled, "%.*s", (int)separatorChars, &text[runEnd * charsPerByte - separatorChars]);
             }
         }
-        if (showPrint && ((printIter + 1) % 16 == 0 || printIter + 1 == bufferLen))
+        else
+        {
+            append_Styled_Text(styled, "%.*s", runChars, &text[runStart * charsPerByte]);
+        }
+        runStart = runEnd;
+    }
+}
+
+//adds one row of a compare dump to the styled text. Bytes set in highlightMask are shown in highlightColor
+static void print_Data_Compare_Row(ptrStyledText styled, char marker, const uint8_t *lineData, uint32_t lineLength, uint64_t offset, bool printOffset, uint8_t offsetWidth, uint16_t highlightMask, eConsoleColors highlightColor, bool showPrint)
+{
+    char hexText[DATA_DUMP_BYTES_PER_LINE * 3] = { 0 };
+    char printText[DATA_DUMP_BYTES_PER_LINE] = { 0 };
+    if (printOffset)
+    {
+        append_Styled_Text(styled, "\n  0x%0*"PRIX64" %c ", offsetWidth, offset, marker);
+    }
+    else
+    {
+        append_Styled_Text(styled, "\n  %*s %c ", offsetWidth + 2, "", marker);
+    }
+    for (uint32_t iter = 0; iter < lineLength; ++iter)
+    {
+        hexText[iter * 3] = dataDumpHexDigits[M_Nibble1(lineData[iter])];
+        hexText[iter * 3 + 1] = dataDumpHexDigits[M_Nibble0(lineData[iter])];
+        hexText[iter * 3 + 2] = ' ';
+        printText[iter] = (lineData[iter] >= 0x20 && lineData[iter] < 0x7F) ? (char)lineData[iter] : '.';
+    }
+    append_Data_Compare_Runs(styled, hexText, 3, 1, lineLength, highlightMask, highlightColor);
+    if (showPrint)
+    {
+        append_Styled_Text(styled, "%*s", (int)((DATA_DUMP_BYTES_PER_LINE - lineLength) * 3 + 2), "");
+        append_Data_Compare_Runs(styled, printText, 1, 0, lineLength, highlightMask, highlightColor);
+    }
+}
+
+int print_Data_Buffer_Differences(const uint8_t *expectedBuffer, const uint8_t *actualBuffer, uint64_t bufferLen, uint32_t contextLines, bool showPrint, ptrDataCompareResult result)
+{
+    dataCompareResult localResult;
+    uint8_t offsetWidth = get_Data_Dump_Offset_Width(bufferLen);
+    uint64_t lineCount = (bufferLen + DATA_DUMP_BYTES_PER_LINE - 1) / DATA_DUMP_BYTES_PER_LINE;
+    uint64_t nextLineToPrint = 0;//everything before this line has been printed or skipped
+    uint32_t trailingContext = 0;
+    styledText styled;
+    if (!expectedBuffer || !actualBuffer)
+    {
+        return BAD_PARAMETER;
+    }
+    if (SUCCESS != init_Styled_Text(&styled, stdout))
+    {
+        return MEMORY_FAILURE;
+    }
+    memset(&localResult, 0, sizeof(dataCompareResult));
+    for (uint64_t line = 0; line < lineCount; ++line)
+    {
+        uint64_t lineOffset = line * DATA_DUMP_BYTES_PER_LINE;
+        uint32_t lineLength = (uint32_t)M_Min(DATA_DUMP_BYTES_PER_LINE, bufferLen - lineOffset);
+        uint16_t differenceMask = 0;
+        if (lineLength == DATA_DUMP_BYTES_PER_LINE)
+        {
+            differenceMask = compare_16_Bytes(&expectedBuffer[lineOffset], &actualBuffer[lineOffset]);
+        }
+        else
+        {
+            for (uint32_t iter = 0; iter < lineLength; ++iter)
+            {
+                if (expectedBuffer[lineOffset + iter] != actualBuffer[lineOffset + iter])
+                {
+                    differenceMask |= (uint16_t)(1 << iter);
+                }
+            }
+        }
+        if (differenceMask)
         {
-            lineBuff[17] = '\0';
-            lineBuffIter = UINT8_MAX;//this is done to cause an overflow when the ++happens during the loop
-            //need to calculate if padding is needed before printing character translations...but how...
-            uint32_t spacePadding = (printIter + 1) % 16;
-            if (spacePadding)
+            uint64_t firstContextLine = line > contextLines ? line - contextLines : 0;
+            if (localResult.differentLines == 0)
             {
-                uint32_t counter = 0;
-                while (counter < ((16 - spacePadding)))
+                //first difference, so print the column header
+                localResult.firstDifferenceOffset = lineOffset + count_Bits_16((uint16_t)((differenceMask & (~differenceMask + 1)) - 1));
+                append_Styled_Text(&styled, "\n  %*s   ", offsetWidth + 2, "");
+                for (uint8_t column = 0; column < DATA_DUMP_BYTES_PER_LINE && column < bufferLen; ++column)
                 {
-                    printf("   ");
-                    counter++;
+                    append_Styled_Text(&styled, "%"PRIX8"  ", column);
                 }
             }
-            //space after last printed hex 
-            printf("  ");
-            printf("%s", lineBuff);
-            memset(lineBuff, 0, sizeof(lineBuff) / sizeof(*lineBuff));
+            if (firstContextLine < nextLineToPrint)
+            {
+                firstContextLine = nextLineToPrint;
+            }
+            if (firstContextLine > nextLineToPrint || (firstContextLine > 0 && localResult.differentLines == 0))
+            {
+                //mark that matching lines were skipped
+                append_Styled_Text(&styled, "\n  *");
+            }
+            for (uint64_t contextLine = firstContextLine; contextLine < line; ++contextLine)
+            {
+                print_Data_Compare_Row(&styled, ' ', &expectedBuffer[contextLine * DATA_DUMP_BYTES_PER_LINE], DATA_DUMP_BYTES_PER_LINE, contextLine * DATA_DUMP_BYTES_PER_LINE, true, offsetWidth, 0, DEFAULT, showPrint);
+            }
+            print_Data_Compare_Row(&styled, '-', &expectedBuffer[lineOffset], lineLength, lineOffset, true, offsetWidth, differenceMask, GREEN, showPrint);
+            print_Data_Compare_Row(&styled, '+', &actualBuffer[lineOffset], lineLength, lineOffset, false, offsetWidth, differenceMask, RED, showPrint);
+            localResult.differentBytes += count_Bits_16(differenceMask);
+            ++localResult.differentLines;
+            nextLineToPrint = line + 1;
+            trailingContext = contextLines;
+        }
+        else if (trailingContext > 0)
+        {
+            print_Data_Compare_Row(&styled, ' ', &expectedBuffer[lineOffset], lineLength, lineOffset, true, offsetWidth, 0, DEFAULT, showPrint);
+            nextLineToPrint = line + 1;
+            --trailingContext;
+        }
+        if (styled.length >= DATA_COMPARE_WRITE_SIZE)
+        {
+            write_Styled_Text(&styled);
         }
     }
-    printf("\n\n");
+    if (localResult.differentLines > 0)
+    {
+        if (nextLineToPrint < lineCount)
+        {
+            append_Styled_Text(&styled, "\n  *");
+        }
+        append_Styled_Text(&styled, "\n\n%"PRIu64" of %"PRIu64" bytes differ in %"PRIu64" of %"PRIu64" lines. First difference at offset 0x%"PRIX64"\n\n", localResult.differentBytes, bufferLen, localResult.differentLines, lineCount, localResult.firstDifferenceOffset);
+    }
+    else
+    {
+        append_Styled_Text(&styled, "\nAll %"PRIu64" bytes match\n\n", bufferLen);
+    }
+    write_Styled_Text(&styled);
+    free_Styled_Text(&styled);
+    if (result)
+    {
+        memcpy(result, &localResult, sizeof(dataCompareResult));
+    }
+    return localResult.differentLines > 0 ? FAILURE : SUCCESS;
 }
 
 int metric_Unit_Convert(double *byteValue, char** metricUnit)
@@ -764,18 +1594,93 @@ int capacity_Unit_Convert(double *byteValue, char** capacityUnit)
     return ret;
 }
 
-bool is_Empty(void *ptrData, size_t lengthBytes)
+#define ZERO_CHECK_BLOCK_SIZE 64
+
+#if defined (OPENSEA_CPU_X86)
+OPENSEA_TARGET("avx2")
+static size_t skip_Zero_Blocks_AVX2(const uint8_t *data, size_t length)
 {
-    if (ptrData)
+    size_t offset = 0;
+    for (; offset + ZERO_CHECK_BLOCK_SIZE <= length; offset += ZERO_CHECK_BLOCK_SIZE)
     {
-        for (size_t iter = 0, iterEnd = lengthBytes - 1; iter < lengthBytes && iterEnd >= 0 && iterEnd >= iter; ++iter, --iterEnd)
+        __m256i combined = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)&data[offset]), _mm256_loadu_si256((const __m256i*)&data[offset + 32]));
+        if (!_mm256_testz_si256(combined, combined))
         {
-            if (((uint_fast8_t*)ptrData)[iter] != UINT8_C(0) || ((uint_fast8_t*)ptrData)[iterEnd] != UINT8_C(0))
-            {
-                return false;
-            }
+            break;
+        }
+    }
+    return offset;
+}
+#endif
+
+//returns the offset of the first ZERO_CHECK_BLOCK_SIZE block that is not all zeros, or of the last partial block when they all are.
+//Each block is ORed together and tested once, so zeros go as fast as they can be loaded and the loop stops at the first block with data.
+static size_t skip_Zero_Blocks(const uint8_t *data, size_t length)
+{
+    size_t offset = 0;
+#if defined (OPENSEA_CPU_X86)
+    if (get_CPU_Features() & CPU_FEATURE_AVX2)
+    {
+        return skip_Zero_Blocks_AVX2(data, length);
+    }
+#endif
+    for (; offset + ZERO_CHECK_BLOCK_SIZE <= length; offset += ZERO_CHECK_BLOCK_SIZE)
+    {
+#if defined (OPENSEA_SIMD_SSE2)
+        __m128i combined = _mm_or_si128(_mm_or_si128(_mm_loadu_si128((const __m128i*)&data[offset]), _mm_loadu_si128((const __m128i*)&data[offset + 16])),
+            _mm_or_si128(_mm_loadu_si128((const __m128i*)&data[offset + 32]), _mm_loadu_si128((const __m128i*)&data[offset + 48])));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(combined, _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+#elif defined (OPENSEA_SIMD_NEON)
+        uint64x2_t combined = vreinterpretq_u64_u8(vorrq_u8(vorrq_u8(vld1q_u8(&data[offset]), vld1q_u8(&data[offset + 16])),
+            vorrq_u8(vld1q_u8(&data[offset + 32]), vld1q_u8(&data[offset + 48]))));
+        if (vgetq_lane_u64(combined, 0) | vgetq_lane_u64(combined, 1))
+        {
+            break;
+        }
+#else
+        uint64_t words[ZERO_CHECK_BLOCK_SIZE / sizeof(uint64_t)];
+        uint64_t combined = 0;
+        memcpy(words, &data[offset], ZERO_CHECK_BLOCK_SIZE);
+        for (uint8_t word = 0; word < ZERO_CHECK_BLOCK_SIZE / sizeof(uint64_t); ++word)
+        {
+            combined |= words[word];
+        }
+        if (combined)
+        {
+            break;
+        }
+#endif
+    }
+    return offset;
+}
+
+size_t find_First_Nonzero_Byte(const void *ptrData, size_t lengthBytes)
+{
+    const uint8_t *data = (const uint8_t*)ptrData;
+    size_t offset = 0;
+    if (!data)
+    {
+        return lengthBytes;
+    }
+    //the blocks find where the data starts, then at most one block (or the partial block at the end) is checked a byte at a time
+    for (offset = skip_Zero_Blocks(data, lengthBytes); offset < lengthBytes; ++offset)
+    {
+        if (data[offset])
+        {
+            break;
         }
-        return true;
+    }
+    return offset;
+}
+
+bool is_Empty(void *ptrData, size_t lengthBytes)
+{
+    if (ptrData)
+    {
+        return find_First_Nonzero_Byte(ptrData, lengthBytes) == lengthBytes;
     }
     return false;
 }
@@ -896,106 +1801,244 @@ void print_Time_To_Screen(uint8_t *years, uint8_t *days, uint8_t *hours, uint8_t
     }
 }
 
-uint32_t seed32Array[2] = { 0x05EAF00D, 0x05EA51DE };
-uint64_t seed64Array[2] = { 0x05EAF00D, 0x05EA51DE };
+#define RANDOM_DEFAULT_SEED UINT64_C(0x05EAF00D05EA51DE) //seed for the shared state that the per thread states are taken from
+
+uint64_t splitmix64(uint64_t *splitState)
+{
+    uint64_t result = (*splitState += SPLITMIX64_INCREMENT);
+    result = (result ^ (result >> 30)) * SPLITMIX64_MULTIPLIER_1;
+    result = (result ^ (result >> 27)) * SPLITMIX64_MULTIPLIER_2;
+    return result ^ (result >> 31);
+}
+
+void seed_Random_State(ptrRandomState rng, uint64_t seed)
+{
+    uint64_t splitState = seed;
+    if (!rng)
+    {
+        return;
+    }
+    //splitmix64 gives different outputs for different inputs, so the state can never be all zeros
+    rng->state[0] = splitmix64(&splitState);
+    rng->state[1] = splitmix64(&splitState);
+    rng->state[2] = splitmix64(&splitState);
+    rng->state[3] = splitmix64(&splitState);
+}
+
+uint64_t random_Next_64(ptrRandomState rng)
+{
+    uint64_t *state = rng->state;
+    uint64_t const result = rotate_Left_64(state[1] * 5, 7) * 9;
+    uint64_t const shifted = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotate_Left_64(state[3], 45);
+    return result;
+}
+
+uint32_t random_Next_32(ptrRandomState rng)
+{
+    //the upper bits are the strongest
+    return (uint32_t)(random_Next_64(rng) >> 32);
+}
+
+//moves the state ahead by the distance the jump polynomial represents
+static void apply_Random_Jump(ptrRandomState rng, const uint64_t jumpPolynomial[4])
+{
+    uint64_t jumped[4] = { 0, 0, 0, 0 };
+    for (uint8_t word = 0; word < 4; ++word)
+    {
+        for (uint8_t bit = 0; bit < 64; ++bit)
+        {
+            if (jumpPolynomial[word] & (UINT64_C(1) << bit))
+            {
+                jumped[0] ^= rng->state[0];
+                jumped[1] ^= rng->state[1];
+                jumped[2] ^= rng->state[2];
+                jumped[3] ^= rng->state[3];
+            }
+            random_Next_64(rng);
+        }
+    }
+    memcpy(rng->state, jumped, sizeof(jumped));
+}
+
+void jump_Random_State(ptrRandomState rng)
+{
+    static const uint64_t jumpPolynomial[4] = { UINT64_C(0x180EC6D33CFD0ABA), UINT64_C(0xD5A61266F0C9392C), UINT64_C(0xA9582618E03FC9AA), UINT64_C(0x39ABDC4529B1661C) };
+    if (rng)
+    {
+        apply_Random_Jump(rng, jumpPolynomial);
+    }
+}
+
+void long_Jump_Random_State(ptrRandomState rng)
+{
+    static const uint64_t longJumpPolynomial[4] = { UINT64_C(0x76E15D3EFEFDCBBF), UINT64_C(0xC5004E441C522FB3), UINT64_C(0x77710069854EE241), UINT64_C(0x39109BB02ACBE635) };
+    if (rng)
+    {
+        apply_Random_Jump(rng, longJumpPolynomial);
+    }
+}
+
+void split_Random_State(ptrRandomState rng, ptrRandomState child)
+{
+    if (!rng || !child)
+    {
+        return;
+    }
+    memcpy(child, rng, sizeof(randomState));
+    jump_Random_State(rng);
+}
+
+static randomState nextThreadRandomState;//long jumped each time a thread takes its stream from it
+static uint32_t nextThreadRandomLock = 0;
+static bool nextThreadRandomSeeded = false;//only used while holding nextThreadRandomLock
+static OPENSEA_THREAD_LOCAL randomState threadRandomState;
+static OPENSEA_THREAD_LOCAL bool threadRandomStateReady = false;
+
+ptrRandomState get_Thread_Random_State(void)
+{
+    if (!threadRandomStateReady)
+    {
+        //only held for one long jump, so yield rather than sleep while another thread has it
+        while (!M_Atomic_Compare_Exchange(&nextThreadRandomLock, 0, 1))
+        {
+            os_Yield_Thread();
+        }
+        if (!nextThreadRandomSeeded)
+        {
+            seed_Random_State(&nextThreadRandomState, RANDOM_DEFAULT_SEED);
+            nextThreadRandomSeeded = true;
+        }
+        memcpy(&threadRandomState, &nextThreadRandomState, sizeof(randomState));
+        long_Jump_Random_State(&nextThreadRandomState);
+        M_Atomic_Store(&nextThreadRandomLock, 0);
+        threadRandomStateReady = true;
+    }
+    return &threadRandomState;
+}
 
 void seed_32(uint32_t seed)
 {
-    //first initialize
-    seed32Array[0] = seed;
-    seed32Array[1] = (uint32_t)((int32_t)seed >> 1);//converting to signed int to perform arithmetic shift, then back for the seed value
-    //using that initialization, run the random number generator for a more random seed...may or may not be needed, but I'm doing this anyways - Tyler
-    seed32Array[0] = xorshiftplus32();
-    seed32Array[0] = xorshiftplus32();
+    seed_Random_State(get_Thread_Random_State(), seed);
 }
+
 void seed_64(uint64_t seed)
 {
-    //first initialize
-    seed64Array[0] = seed;
-    seed64Array[1] = (uint64_t)((int64_t)seed >> 2);//converting to signed int to perform arithmetic shift, then back for the seed value
-    //using that initialization, run the random number generator for a more random seed...may or may not be needed, but I'm doing this anyways - Tyler
-    seed64Array[0] = xorshiftplus64();
-    seed64Array[0] = xorshiftplus64();
+    seed_Random_State(get_Thread_Random_State(), seed);
 }
 
-//shift values chosen randomly
 uint32_t xorshiftplus32(void)
 {
-    uint32_t x = seed32Array[0];
-    uint32_t const y = seed32Array[1];
-    seed32Array[0] = y;
-    x ^= x << 13;//a
-    seed32Array[1] = x ^ y ^ (x >> 17) ^ (y >> 7); //b, c
-    return (seed32Array[1] + y);
+    return random_Next_32(get_Thread_Random_State());
 }
 
-//shift values chosen randomly
 uint64_t xorshiftplus64(void)
 {
-    uint64_t x = seed64Array[0];
-    uint64_t const y = seed64Array[1];
-    seed64Array[0] = y;
-    x ^= x << 27;//a
-    seed64Array[1] = x ^ y ^ (x >> 13) ^ (y >> 32); //b, c
-    return (seed64Array[1] + y);
+    return random_Next_64(get_Thread_Random_State());
 }
 
-uint32_t random_Range_32(uint32_t rangeMin, uint32_t rangeMax)
+uint64_t multiply_64_To_128(uint64_t value1, uint64_t value2, uint64_t *highBits)
+{
+#if defined (__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)value1 * value2;
+    *highBits = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#elif defined (_MSC_VER) && (defined (_M_X64) || defined (_M_AMD64))
+    return _umul128(value1, value2, highBits);
+#else
+    //schoolbook multiply on 32bit halves
+    uint64_t lowLow = (value1 & UINT32_MAX) * (value2 & UINT32_MAX);
+    uint64_t highLow = (value1 >> 32) * (value2 & UINT32_MAX);
+    uint64_t lowHigh = (value1 & UINT32_MAX) * (value2 >> 32);
+    uint64_t highHigh = (value1 >> 32) * (value2 >> 32);
+    uint64_t middle = (lowLow >> 32) + (highLow & UINT32_MAX) + lowHigh;
+    *highBits = highHigh + (highLow >> 32) + (middle >> 32);
+    return (middle << 32) | (lowLow & UINT32_MAX);
+#endif
+}
+
+//Lemire's multiply-shift: the high half of random * range is evenly spread over the range once products with a low half under 2^N % range are thrown away.
+//That only happens when the low half is also under range, so the division to find the threshold is almost never needed.
+uint32_t random_State_Range_32(ptrRandomState rng, uint32_t rangeMin, uint32_t rangeMax)
 {
-    //doing this to prevent a possible overflow
-    if (rangeMax == UINT32_MAX)
+    uint32_t range = 0;
+    uint64_t product = 0;
+    if (rangeMin > rangeMax)
     {
-        rangeMax -= 1;
+        uint32_t swap = rangeMin;
+        rangeMin = rangeMax;
+        rangeMax = swap;
     }
-    //this will slightly bias the randomness...but not enough for us to care at this point in time
-    //return (xorshiftplus32() % (rangeMax + 1 - rangeMin) + rangeMin);
-
-    //This method below should return unbiased results. see http://c-faq.com/lib/randrange.html
-    uint32_t d = (UINT32_MAX / (rangeMax - rangeMin + 1) + 1);
-    if (d > 0)
+    range = rangeMax - rangeMin + 1;
+    if (range == 0)
     {
-        return (rangeMin + xorshiftplus32() / d);
+        //full 32bit range
+        return random_Next_32(rng);
     }
-    else
+    product = (uint64_t)random_Next_32(rng) * range;
+    if ((uint32_t)product < range)
     {
-        return 0;
+        uint32_t threshold = (0 - range) % range;
+        while ((uint32_t)product < threshold)
+        {
+            product = (uint64_t)random_Next_32(rng) * range;
+        }
     }
+    return rangeMin + (uint32_t)(product >> 32);
 }
-uint64_t random_Range_64(uint64_t rangeMin, uint64_t rangeMax)
+
+uint64_t random_State_Range_64(ptrRandomState rng, uint64_t rangeMin, uint64_t rangeMax)
 {
-    //doing this to prevent a possible overflow
-    if (rangeMax == UINT64_MAX)
+    uint64_t range = 0;
+    uint64_t productLow = 0;
+    uint64_t productHigh = 0;
+    if (rangeMin > rangeMax)
     {
-        rangeMax -= 1;
+        uint64_t swap = rangeMin;
+        rangeMin = rangeMax;
+        rangeMax = swap;
     }
-    //this will slightly bias the randomness...but not enough for us to care at this point in time
-    //return (xorshiftplus64() % (rangeMax + 1 - rangeMin) + rangeMin);
-
-    //This method below should return unbiased results. see http://c-faq.com/lib/randrange.html
-    uint64_t d = (UINT64_MAX / (rangeMax - rangeMin + 1) + 1);
-    if (d > 0)
+    range = rangeMax - rangeMin + 1;
+    if (range == 0)
     {
-        return (rangeMin + xorshiftplus64() / d);
+        //full 64bit range
+        return random_Next_64(rng);
     }
-    else
+    productLow = multiply_64_To_128(random_Next_64(rng), range, &productHigh);
+    if (productLow < range)
     {
-        return 0;
+        uint64_t threshold = (0 - range) % range;
+        while (productLow < threshold)
+        {
+            productLow = multiply_64_To_128(random_Next_64(rng), range, &productHigh);
+        }
     }
+    return rangeMin + productHigh;
+}
+
+uint32_t random_Range_32(uint32_t rangeMin, uint32_t rangeMax)
+{
+    return random_State_Range_32(get_Thread_Random_State(), rangeMin, rangeMax);
+}
+
+uint64_t random_Range_64(uint64_t rangeMin, uint64_t rangeMax)
+{
+    return random_State_Range_64(get_Thread_Random_State(), rangeMin, rangeMax);
 }
 
 int fill_Random_Pattern_In_Buffer(uint8_t *ptrData, uint32_t dataLength)
 {
-    uint32_t *localPtr = (uint32_t*)ptrData;
     if (dataLength < sizeof(uint32_t) || !ptrData)
     {
         return BAD_PARAMETER;
     }
-    seed_32((uint32_t)time(NULL));
-    for (uint32_t iter = 0; iter < (dataLength / sizeof(uint32_t)); ++iter)
-    {
-        localPtr[iter] = xorshiftplus32();
-    }
-    return SUCCESS;
+    //each call takes a new seed from this thread's generator, so calls made close together (or from different threads) get different data
+    return fill_Seeded_Random_Pattern_In_Buffer(random_Next_64(get_Thread_Random_State()), ptrData, dataLength);
 }
 
 int fill_Hex_Pattern_In_Buffer(uint32_t hexPattern, uint8_t *ptrData, uint32_t dataLength)
@@ -1031,11 +2074,7 @@ int fill_ASCII_Pattern_In_Buffer(const char *asciiPattern, uint32_t patternLengt
     {
         return BAD_PARAMETER;
     }
-    for (uint32_t iter = 0; iter < dataLength; iter += patternLength)
-    {
-        memcpy(&ptrData[iter], asciiPattern, M_Min(patternLength, dataLength - iter));
-    }
-    return SUCCESS;
+    return fill_Repeating_Pattern_In_Buffer((const uint8_t*)asciiPattern, patternLength, ptrData, dataLength);
 }
 
 int fill_Pattern_Buffer_Into_Another_Buffer(uint8_t *inPattern, uint32_t inpatternLength, uint8_t *ptrData, uint32_t dataLength)
@@ -1044,11 +2083,7 @@ int fill_Pattern_Buffer_Into_Another_Buffer(uint8_t *inPattern, uint32_t inpatte
     {
         return BAD_PARAMETER;
     }
-    for (uint32_t iter = 0; iter < dataLength; iter += inpatternLength)
-    {
-        memcpy(&ptrData[iter], inPattern, M_Min(inpatternLength, dataLength - iter));
-    }
-    return SUCCESS;
+    return fill_Repeating_Pattern_In_Buffer(inPattern, inpatternLength, ptrData, dataLength);
 }
 
 double convert_128bit_to_double(uint8_t * pData)
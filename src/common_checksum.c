@@ -0,0 +1,350 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_checksum.c
+// \brief Implements CRC32C and CRC64 checksums of data buffers, using CPU instructions for them when available
+//
+#include "common_checksum.h"
+
+//Both CRCs are reflected, so internally they are worked on as a "raw" register that is inverted on the way in and out.
+//Every version here (hardware, folding, and tables) works on that raw register, so they can be mixed within one CRC.
+#if defined (OPENSEA_CPU_X86)
+#include <immintrin.h>
+#define OPENSEA_CRC32C_HARDWARE
+#define CRC32C_HARDWARE_FEATURE CPU_FEATURE_SSE4_2
+#define CRC32C_HARDWARE_TARGET OPENSEA_TARGET("sse4.2")
+#define CRC32C_HARDWARE_BYTE(crc, value) _mm_crc32_u8(crc, value)
+#if defined (__x86_64__) || defined (_M_X64) || defined (_M_AMD64)
+#define CRC32C_HARDWARE_WORD(crc, value) (uint32_t)_mm_crc32_u64(crc, value)
+#else
+#define CRC32C_HARDWARE_WORD(crc, value) _mm_crc32_u32(_mm_crc32_u32(crc, (uint32_t)(value)), (uint32_t)((value) >> 32))
+#endif
+#elif (defined (__aarch64__) && !defined (__AARCH64EB__)) || defined (_M_ARM64)
+#if defined (_MSC_VER)
+#include <intrin.h>
+#define CRC32C_HARDWARE_TARGET
+#else
+#include <arm_acle.h>
+#if defined (__clang__)
+#define CRC32C_HARDWARE_TARGET OPENSEA_TARGET("crc")
+#else
+#define CRC32C_HARDWARE_TARGET OPENSEA_TARGET("+crc")
+#endif
+#endif
+#define OPENSEA_CRC32C_HARDWARE
+#define CRC32C_HARDWARE_FEATURE CPU_FEATURE_ARM_CRC32
+#define CRC32C_HARDWARE_BYTE(crc, value) __crc32cb(crc, value)
+#define CRC32C_HARDWARE_WORD(crc, value) __crc32cd(crc, value)
+#endif
+#if defined (OPENSEA_CRC32C_HARDWARE)
+//Only little endian CPUs get here. This is a macro because functions without the hardware target are not inlined into the ones with it.
+#define CRC32C_LOAD_WORD(word, pointer) memcpy(&(word), (pointer), sizeof(uint64_t))
+#endif
+
+#define CRC32C_POLYNOMIAL UINT32_C(0x82F63B78)
+#define CRC64_POLYNOMIAL UINT64_C(0x9A6C9329AC4BC9B5)
+#define CRC32C_INTERLEAVE_LENGTH 1024 //each of the 3 hardware streams does this much per loop before they are combined
+#define CRC64_FOLD_MIN_LENGTH 64
+
+//PCLMULQDQ folding constants for CRC64_POLYNOMIAL. Each pair is the bit reflected x^(n+63) and x^(n-1) mod P for folding 128 bits forward n bits.
+#define CRC64_FOLD_512_LOW UINT64_C(0x0C32CDB31E18A84A)
+#define CRC64_FOLD_512_HIGH UINT64_C(0x62242240ACE5045A)
+#define CRC64_FOLD_128_LOW UINT64_C(0xEADC41FD2BA3D420)
+#define CRC64_FOLD_128_HIGH UINT64_C(0x21E9761E252621AC)
+
+//tables are built on first use. 0 = not built, 1 = being built, 2 = ready
+static uint32_t checksumTablesState = 0;
+static uint32_t crc32cTable[8][256];
+static uint64_t crc64Table[8][256];
+static uint32_t crc32cShiftTable[4][256];//moves a raw CRC32C forward over CRC32C_INTERLEAVE_LENGTH zero bytes
+
+static void build_Checksum_Tables(void)
+{
+    uint32_t bitShift[32];
+    for (uint16_t value = 0; value < 256; ++value)
+    {
+        uint32_t crc32 = value;
+        uint64_t crc64 = value;
+        for (uint8_t bit = 0; bit < 8; ++bit)
+        {
+            crc32 = (crc32 >> 1) ^ ((crc32 & 1) ? CRC32C_POLYNOMIAL : 0);
+            crc64 = (crc64 >> 1) ^ ((crc64 & 1) ? CRC64_POLYNOMIAL : 0);
+        }
+        crc32cTable[0][value] = crc32;
+        crc64Table[0][value] = crc64;
+    }
+    //table N is table 0 moved forward N more bytes, for slicing-by-8
+    for (uint8_t slice = 1; slice < 8; ++slice)
+    {
+        for (uint16_t value = 0; value < 256; ++value)
+        {
+            crc32cTable[slice][value] = (crc32cTable[slice - 1][value] >> 8) ^ crc32cTable[0][crc32cTable[slice - 1][value] & 0xFF];
+            crc64Table[slice][value] = (crc64Table[slice - 1][value] >> 8) ^ crc64Table[0][crc64Table[slice - 1][value] & 0xFF];
+        }
+    }
+    //moving a CRC over zeros is linear, so find where each bit goes, then combine those for each byte value
+    for (uint8_t bit = 0; bit < 32; ++bit)
+    {
+        uint32_t crc = UINT32_C(1) << bit;
+        for (uint32_t zeroByte = 0; zeroByte < CRC32C_INTERLEAVE_LENGTH; ++zeroByte)
+        {
+            crc = crc32cTable[0][crc & 0xFF] ^ (crc >> 8);
+        }
+        bitShift[bit] = crc;
+    }
+    for (uint8_t byteNumber = 0; byteNumber < 4; ++byteNumber)
+    {
+        for (uint16_t value = 0; value < 256; ++value)
+        {
+            uint32_t shifted = 0;
+            for (uint8_t bit = 0; bit < 8; ++bit)
+            {
+                if (value & (1 << bit))
+                {
+                    shifted ^= bitShift[byteNumber * 8 + bit];
+                }
+            }
+            crc32cShiftTable[byteNumber][value] = shifted;
+        }
+    }
+}
+
+static void init_Checksum_Tables(void)
+{
+    if (M_Atomic_Load(&checksumTablesState) == 2)
+    {
+        return;
+    }
+    if (M_Atomic_Compare_Exchange(&checksumTablesState, 0, 1))
+    {
+        build_Checksum_Tables();
+        M_Atomic_Store(&checksumTablesState, 2);
+        return;
+    }
+    //another thread is building them. It only takes a moment, but let it have the processor in case it was preempted.
+    while (M_Atomic_Load(&checksumTablesState) != 2)
+    {
+        os_Yield_Thread();
+    }
+}
+
+static uint32_t crc32c_Table(uint32_t crc, const uint8_t *data, size_t length)
+{
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        uint64_t word = load_Little_Endian_64(data) ^ crc;
+        crc = crc32cTable[7][word & 0xFF] ^ crc32cTable[6][(word >> 8) & 0xFF] ^ crc32cTable[5][(word >> 16) & 0xFF] ^ crc32cTable[4][(word >> 24) & 0xFF]
+            ^ crc32cTable[3][(word >> 32) & 0xFF] ^ crc32cTable[2][(word >> 40) & 0xFF] ^ crc32cTable[1][(word >> 48) & 0xFF] ^ crc32cTable[0][word >> 56];
+    }
+    for (; length > 0; ++data, --length)
+    {
+        crc = crc32cTable[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static uint64_t crc64_Table(uint64_t crc, const uint8_t *data, size_t length)
+{
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        uint64_t word = load_Little_Endian_64(data) ^ crc;
+        crc = crc64Table[7][word & 0xFF] ^ crc64Table[6][(word >> 8) & 0xFF] ^ crc64Table[5][(word >> 16) & 0xFF] ^ crc64Table[4][(word >> 24) & 0xFF]
+            ^ crc64Table[3][(word >> 32) & 0xFF] ^ crc64Table[2][(word >> 40) & 0xFF] ^ crc64Table[1][(word >> 48) & 0xFF] ^ crc64Table[0][word >> 56];
+    }
+    for (; length > 0; ++data, --length)
+    {
+        crc = crc64Table[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined (OPENSEA_CRC32C_HARDWARE)
+static uint32_t shift_CRC32C(uint32_t crc)
+{
+    return crc32cShiftTable[0][crc & 0xFF] ^ crc32cShiftTable[1][(crc >> 8) & 0xFF] ^ crc32cShiftTable[2][(crc >> 16) & 0xFF] ^ crc32cShiftTable[3][crc >> 24];
+}
+
+//The CRC32 instruction can start every cycle but takes 3 cycles to finish, so 3 independent pieces are run at once,
+//then the first two are moved forward over the pieces after them and combined
+CRC32C_HARDWARE_TARGET
+static uint32_t crc32c_Hardware(uint32_t crc, const uint8_t *data, size_t length)
+{
+    for (; length >= 3 * CRC32C_INTERLEAVE_LENGTH; data += 3 * CRC32C_INTERLEAVE_LENGTH, length -= 3 * CRC32C_INTERLEAVE_LENGTH)
+    {
+        uint32_t crc1 = 0;
+        uint32_t crc2 = 0;
+        for (uint32_t offset = 0; offset < CRC32C_INTERLEAVE_LENGTH; offset += 8)
+        {
+            uint64_t word0 = 0;
+            uint64_t word1 = 0;
+            uint64_t word2 = 0;
+            CRC32C_LOAD_WORD(word0, &data[offset]);
+            CRC32C_LOAD_WORD(word1, &data[CRC32C_INTERLEAVE_LENGTH + offset]);
+            CRC32C_LOAD_WORD(word2, &data[2 * CRC32C_INTERLEAVE_LENGTH + offset]);
+            crc = CRC32C_HARDWARE_WORD(crc, word0);
+            crc1 = CRC32C_HARDWARE_WORD(crc1, word1);
+            crc2 = CRC32C_HARDWARE_WORD(crc2, word2);
+        }
+        crc = shift_CRC32C(crc) ^ crc1;
+        crc = shift_CRC32C(crc) ^ crc2;
+    }
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        uint64_t word = 0;
+        CRC32C_LOAD_WORD(word, data);
+        crc = CRC32C_HARDWARE_WORD(crc, word);
+    }
+    for (; length > 0; ++data, --length)
+    {
+        crc = CRC32C_HARDWARE_BYTE(crc, *data);
+    }
+    return crc;
+}
+
+//3 sectors at a time. Each sector has its own CRC so nothing needs to be combined.
+CRC32C_HARDWARE_TARGET
+static void crc32c_Hardware_3_Sectors(const uint8_t *data, uint32_t sectorSize, uint32_t *crcs)
+{
+    uint32_t crc0 = UINT32_MAX;
+    uint32_t crc1 = UINT32_MAX;
+    uint32_t crc2 = UINT32_MAX;
+    uint32_t offset = 0;
+    for (; offset + 8 <= sectorSize; offset += 8)
+    {
+        uint64_t word0 = 0;
+        uint64_t word1 = 0;
+        uint64_t word2 = 0;
+        CRC32C_LOAD_WORD(word0, &data[offset]);
+        CRC32C_LOAD_WORD(word1, &data[sectorSize + offset]);
+        CRC32C_LOAD_WORD(word2, &data[2 * (size_t)sectorSize + offset]);
+        crc0 = CRC32C_HARDWARE_WORD(crc0, word0);
+        crc1 = CRC32C_HARDWARE_WORD(crc1, word1);
+        crc2 = CRC32C_HARDWARE_WORD(crc2, word2);
+    }
+    for (; offset < sectorSize; ++offset)
+    {
+        crc0 = CRC32C_HARDWARE_BYTE(crc0, data[offset]);
+        crc1 = CRC32C_HARDWARE_BYTE(crc1, data[sectorSize + offset]);
+        crc2 = CRC32C_HARDWARE_BYTE(crc2, data[2 * (size_t)sectorSize + offset]);
+    }
+    crcs[0] = ~crc0;
+    crcs[1] = ~crc1;
+    crcs[2] = ~crc2;
+}
+#endif
+
+#if defined (OPENSEA_CPU_X86)
+//Folds the buffer down to 128 bits with carryless multiplies, 4 x 128 bits at a time, then finishes the last 16 bytes and any tail with the table.
+//length must be at least CRC64_FOLD_MIN_LENGTH
+OPENSEA_TARGET("pclmul")
+static uint64_t crc64_PCLMUL(uint64_t crc, const uint8_t *data, size_t length)
+{
+    uint8_t folded[16];
+    __m128i fold512 = _mm_set_epi64x((long long)CRC64_FOLD_512_HIGH, (long long)CRC64_FOLD_512_LOW);
+    __m128i fold128 = _mm_set_epi64x((long long)CRC64_FOLD_128_HIGH, (long long)CRC64_FOLD_128_LOW);
+    //the raw CRC lines up with the first 8 bytes of the data
+    __m128i value0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), _mm_set_epi64x(0, (long long)crc));
+    __m128i value1 = _mm_loadu_si128((const __m128i*)(data + 16));
+    __m128i value2 = _mm_loadu_si128((const __m128i*)(data + 32));
+    __m128i value3 = _mm_loadu_si128((const __m128i*)(data + 48));
+    data += 64;
+    length -= 64;
+    for (; length >= 64; data += 64, length -= 64)
+    {
+        value0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value0, fold512, 0x00), _mm_clmulepi64_si128(value0, fold512, 0x11)), _mm_loadu_si128((const __m128i*)data));
+        value1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value1, fold512, 0x00), _mm_clmulepi64_si128(value1, fold512, 0x11)), _mm_loadu_si128((const __m128i*)(data + 16)));
+        value2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value2, fold512, 0x00), _mm_clmulepi64_si128(value2, fold512, 0x11)), _mm_loadu_si128((const __m128i*)(data + 32)));
+        value3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value3, fold512, 0x00), _mm_clmulepi64_si128(value3, fold512, 0x11)), _mm_loadu_si128((const __m128i*)(data + 48)));
+    }
+    //fold the 4 values into 1, then any remaining whole 16 byte pieces
+    value0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value0, fold128, 0x00), _mm_clmulepi64_si128(value0, fold128, 0x11)), value1);
+    value0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value0, fold128, 0x00), _mm_clmulepi64_si128(value0, fold128, 0x11)), value2);
+    value0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value0, fold128, 0x00), _mm_clmulepi64_si128(value0, fold128, 0x11)), value3);
+    for (; length >= 16; data += 16, length -= 16)
+    {
+        value0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value0, fold128, 0x00), _mm_clmulepi64_si128(value0, fold128, 0x11)), _mm_loadu_si128((const __m128i*)data));
+    }
+    //the folded value has the same CRC as the data it replaced, starting from a raw CRC of 0
+    _mm_storeu_si128((__m128i*)folded, value0);
+    return crc64_Table(crc64_Table(0, folded, sizeof(folded)), data, length);
+}
+#endif
+
+uint32_t update_CRC32C(uint32_t crc, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t*)data;
+    if (!data || length == 0)
+    {
+        return crc;
+    }
+    init_Checksum_Tables();
+#if defined (OPENSEA_CRC32C_HARDWARE)
+    if (get_CPU_Features() & CRC32C_HARDWARE_FEATURE)
+    {
+        return ~crc32c_Hardware(~crc, bytes, length);
+    }
+#endif
+    return ~crc32c_Table(~crc, bytes, length);
+}
+
+uint64_t update_CRC64(uint64_t crc, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t*)data;
+    if (!data || length == 0)
+    {
+        return crc;
+    }
+    init_Checksum_Tables();
+#if defined (OPENSEA_CPU_X86)
+    if (length >= CRC64_FOLD_MIN_LENGTH && (get_CPU_Features() & CPU_FEATURE_PCLMULQDQ))
+    {
+        return ~crc64_PCLMUL(~crc, bytes, length);
+    }
+#endif
+    return ~crc64_Table(~crc, bytes, length);
+}
+
+int calculate_Sector_CRC32C(const uint8_t *data, uint32_t sectorSize, size_t sectorCount, uint32_t *crcs)
+{
+    size_t sector = 0;
+    if (!data || !crcs || sectorSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    init_Checksum_Tables();
+#if defined (OPENSEA_CRC32C_HARDWARE)
+    if (get_CPU_Features() & CRC32C_HARDWARE_FEATURE)
+    {
+        for (; sector + 3 <= sectorCount; sector += 3)
+        {
+            crc32c_Hardware_3_Sectors(&data[sector * sectorSize], sectorSize, &crcs[sector]);
+        }
+    }
+#endif
+    for (; sector < sectorCount; ++sector)
+    {
+        crcs[sector] = update_CRC32C(CRC32C_START_VALUE, &data[sector * sectorSize], sectorSize);
+    }
+    return SUCCESS;
+}
+
+int calculate_Sector_CRC64(const uint8_t *data, uint32_t sectorSize, size_t sectorCount, uint64_t *crcs)
+{
+    if (!data || !crcs || sectorSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    for (size_t sector = 0; sector < sectorCount; ++sector)
+    {
+        crcs[sector] = update_CRC64(CRC64_START_VALUE, &data[sector * sectorSize], sectorSize);
+    }
+    return SUCCESS;
+}
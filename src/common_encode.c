@@ -0,0 +1,650 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_encode.c
+// \brief Implements hex and base64 encoding and decoding of binary data into caller provided buffers
+//
+#include "common_encode.h"
+
+//Each encode/decode has a scalar version that handles any length, plus SIMD kernels that handle as many whole blocks as they can and return how much they did.
+//The scalar version then finishes whatever is left. SSSE3 and AVX2 are picked at runtime. NEON is part of the aarch64 baseline.
+#if defined (OPENSEA_CPU_X86)
+#include <immintrin.h>
+#elif defined (__aarch64__) || defined (_M_ARM64)
+#define OPENSEA_ENCODE_NEON
+#include <arm_neon.h>
+#endif
+
+static const char hexDigitsUpper[] = "0123456789ABCDEF";
+static const char hexDigitsLower[] = "0123456789abcdef";
+static const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//returns 0xFF for anything that is not a hex digit
+static uint8_t hex_Digit_Value(char character)
+{
+    if (character >= '0' && character <= '9')
+    {
+        return (uint8_t)(character - '0');
+    }
+    else if (character >= 'A' && character <= 'F')
+    {
+        return (uint8_t)(character - 'A' + 10);
+    }
+    else if (character >= 'a' && character <= 'f')
+    {
+        return (uint8_t)(character - 'a' + 10);
+    }
+    return 0xFF;
+}
+
+//returns 0xFF for anything that is not in the base64 alphabet, including the '=' padding
+static uint8_t base64_Character_Value(char character)
+{
+    if (character >= 'A' && character <= 'Z')
+    {
+        return (uint8_t)(character - 'A');
+    }
+    else if (character >= 'a' && character <= 'z')
+    {
+        return (uint8_t)(character - 'a' + 26);
+    }
+    else if (character >= '0' && character <= '9')
+    {
+        return (uint8_t)(character - '0' + 52);
+    }
+    else if (character == '+')
+    {
+        return 62;
+    }
+    else if (character == '/')
+    {
+        return 63;
+    }
+    return 0xFF;
+}
+
+static void hex_Encode_Scalar(const uint8_t *data, size_t dataLength, char *output, const char *digits)
+{
+    for (size_t iter = 0; iter < dataLength; ++iter)
+    {
+        output[iter * 2] = digits[data[iter] >> 4];
+        output[iter * 2 + 1] = digits[data[iter] & 0x0F];
+    }
+}
+
+static int hex_Decode_Scalar(const char *hex, size_t byteCount, uint8_t *output)
+{
+    for (size_t iter = 0; iter < byteCount; ++iter)
+    {
+        uint8_t high = hex_Digit_Value(hex[iter * 2]);
+        uint8_t low = hex_Digit_Value(hex[iter * 2 + 1]);
+        if ((high | low) & 0xF0)
+        {
+            return FAILURE;
+        }
+        output[iter] = (uint8_t)((high << 4) | low);
+    }
+    return SUCCESS;
+}
+
+//dataLength must be a multiple of 3. The padded final group is written by base64_Encode.
+static void base64_Encode_Scalar(const uint8_t *data, size_t dataLength, char *output)
+{
+    for (size_t offset = 0; offset < dataLength; offset += 3, output += 4)
+    {
+        uint32_t group = ((uint32_t)data[offset] << 16) | ((uint32_t)data[offset + 1] << 8) | data[offset + 2];
+        output[0] = base64Alphabet[(group >> 18) & 0x3F];
+        output[1] = base64Alphabet[(group >> 12) & 0x3F];
+        output[2] = base64Alphabet[(group >> 6) & 0x3F];
+        output[3] = base64Alphabet[group & 0x3F];
+    }
+}
+
+//characterCount must be a multiple of 4 with no padding. The final partial group is decoded by base64_Decode.
+static int base64_Decode_Scalar(const char *base64, size_t characterCount, uint8_t *output)
+{
+    for (size_t offset = 0; offset < characterCount; offset += 4, output += 3)
+    {
+        uint8_t value0 = base64_Character_Value(base64[offset]);
+        uint8_t value1 = base64_Character_Value(base64[offset + 1]);
+        uint8_t value2 = base64_Character_Value(base64[offset + 2]);
+        uint8_t value3 = base64_Character_Value(base64[offset + 3]);
+        uint32_t group = 0;
+        if ((value0 | value1 | value2 | value3) & 0xC0)
+        {
+            return FAILURE;
+        }
+        group = ((uint32_t)value0 << 18) | ((uint32_t)value1 << 12) | ((uint32_t)value2 << 6) | value3;
+        output[0] = (uint8_t)(group >> 16);
+        output[1] = (uint8_t)(group >> 8);
+        output[2] = (uint8_t)group;
+    }
+    return SUCCESS;
+}
+
+#if defined (OPENSEA_CPU_X86)
+//16 bytes in, 32 characters out. The nibbles are turned into characters with a table lookup done by pshufb.
+OPENSEA_TARGET("ssse3")
+static size_t hex_Encode_SSSE3(const uint8_t *data, size_t dataLength, char *output, const char *digits)
+{
+    const __m128i digitTable = _mm_loadu_si128((const __m128i*)digits);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    size_t offset = 0;
+    for (; offset + 16 <= dataLength; offset += 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)&data[offset]);
+        __m128i high = _mm_shuffle_epi8(digitTable, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask));
+        __m128i low = _mm_shuffle_epi8(digitTable, _mm_and_si128(bytes, nibbleMask));
+        _mm_storeu_si128((__m128i*)&output[offset * 2], _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i*)&output[offset * 2 + 16], _mm_unpackhi_epi8(high, low));
+    }
+    return offset;
+}
+
+//32 bytes in, 64 characters out
+OPENSEA_TARGET("avx2")
+static size_t hex_Encode_AVX2(const uint8_t *data, size_t dataLength, char *output, const char *digits)
+{
+    const __m256i digitTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)digits));
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    size_t offset = 0;
+    for (; offset + 32 <= dataLength; offset += 32)
+    {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)&data[offset]);
+        __m256i high = _mm256_shuffle_epi8(digitTable, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibbleMask));
+        __m256i low = _mm256_shuffle_epi8(digitTable, _mm256_and_si256(bytes, nibbleMask));
+        //the unpacks work inside each 128bit lane, so put the lanes back in order
+        __m256i first = _mm256_unpacklo_epi8(high, low);
+        __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256((__m256i*)&output[offset * 2], _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i*)&output[offset * 2 + 32], _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return offset;
+}
+
+//Converts hex characters to their values. Lanes that are not hex digits are cleared in valid.
+OPENSEA_TARGET("ssse3")
+static __m128i hex_Digit_Values_SSSE3(__m128i characters, __m128i *valid)
+{
+    __m128i digits = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+    __m128i letters = _mm_sub_epi8(_mm_or_si128(characters, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+    *valid = _mm_and_si128(*valid, _mm_or_si128(isDigit, isLetter));
+    return _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+}
+
+//32 characters in, 16 bytes out. Stops at the first block with an invalid character so the scalar code can report it.
+OPENSEA_TARGET("ssse3")
+static size_t hex_Decode_SSSE3(const char *hex, size_t byteCount, uint8_t *output)
+{
+    const __m128i nibbleWeights = _mm_set1_epi16(0x0110);//high nibble * 16 + low nibble for each pair of characters
+    size_t offset = 0;
+    for (; offset + 16 <= byteCount; offset += 16)
+    {
+        __m128i valid = _mm_set1_epi8(-1);
+        __m128i first = hex_Digit_Values_SSSE3(_mm_loadu_si128((const __m128i*)&hex[offset * 2]), &valid);
+        __m128i second = hex_Digit_Values_SSSE3(_mm_loadu_si128((const __m128i*)&hex[offset * 2 + 16]), &valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+        {
+            break;
+        }
+        first = _mm_maddubs_epi16(first, nibbleWeights);
+        second = _mm_maddubs_epi16(second, nibbleWeights);
+        _mm_storeu_si128((__m128i*)&output[offset], _mm_packus_epi16(first, second));
+    }
+    return offset;
+}
+
+OPENSEA_TARGET("avx2")
+static __m256i hex_Digit_Values_AVX2(__m256i characters, __m256i *valid)
+{
+    __m256i digits = _mm256_sub_epi8(characters, _mm256_set1_epi8('0'));
+    __m256i letters = _mm256_sub_epi8(_mm256_or_si256(characters, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+    __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+    *valid = _mm256_and_si256(*valid, _mm256_or_si256(isDigit, isLetter));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digits), _mm256_and_si256(isLetter, _mm256_add_epi8(letters, _mm256_set1_epi8(10))));
+}
+
+//64 characters in, 32 bytes out
+OPENSEA_TARGET("avx2")
+static size_t hex_Decode_AVX2(const char *hex, size_t byteCount, uint8_t *output)
+{
+    const __m256i nibbleWeights = _mm256_set1_epi16(0x0110);
+    size_t offset = 0;
+    for (; offset + 32 <= byteCount; offset += 32)
+    {
+        __m256i valid = _mm256_set1_epi8(-1);
+        __m256i first = hex_Digit_Values_AVX2(_mm256_loadu_si256((const __m256i*)&hex[offset * 2]), &valid);
+        __m256i second = hex_Digit_Values_AVX2(_mm256_loadu_si256((const __m256i*)&hex[offset * 2 + 32]), &valid);
+        if (_mm256_movemask_epi8(valid) != -1)
+        {
+            break;
+        }
+        first = _mm256_maddubs_epi16(first, nibbleWeights);
+        second = _mm256_maddubs_epi16(second, nibbleWeights);
+        //packus works inside each 128bit lane, leaving the 64bit quarters in the order 0, 2, 1, 3
+        _mm256_storeu_si256((__m256i*)&output[offset], _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8));
+    }
+    return offset;
+}
+
+//Takes 12 bytes (in 16 byte lanes) and returns 16 base64 characters. Uses the multiply based bit shuffling from Wojciech Mula's base64 work.
+OPENSEA_TARGET("ssse3")
+static __m128i base64_Characters_SSSE3(__m128i input)
+{
+    //'A' for 0-25, 'a'-26 for 26-51, '0'-52 for 52-61, then '+' and '/'
+    const __m128i offsetTable = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i indices;
+    __m128i offsetIndex;
+    //each 32bit lane gets bytes 1, 0, 2, 1 of a group of 3 so that the 6bit values can be moved into place with multiplies
+    input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    indices = _mm_or_si128(_mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040)),
+                           _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010)));
+    offsetIndex = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    offsetIndex = _mm_or_si128(offsetIndex, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(offsetTable, offsetIndex), indices);
+}
+
+//12 bytes in, 16 characters out. Each load reads 16 bytes, so the loop stops while 16 are still available.
+OPENSEA_TARGET("ssse3")
+static size_t base64_Encode_SSSE3(const uint8_t *data, size_t dataLength, char *output)
+{
+    size_t offset = 0;
+    for (; offset + 16 <= dataLength; offset += 12, output += 16)
+    {
+        _mm_storeu_si128((__m128i*)output, base64_Characters_SSSE3(_mm_loadu_si128((const __m128i*)&data[offset])));
+    }
+    return offset;
+}
+
+OPENSEA_TARGET("avx2")
+static __m256i base64_Characters_AVX2(__m256i input)
+{
+    const __m256i offsetTable = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+    __m256i indices;
+    __m256i offsetIndex;
+    input = _mm256_shuffle_epi8(input, _mm256_broadcastsi128_si256(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1)));
+    indices = _mm256_or_si256(_mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040)),
+                              _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010)));
+    offsetIndex = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    offsetIndex = _mm256_or_si256(offsetIndex, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(offsetTable, offsetIndex), indices);
+}
+
+//24 bytes in (12 per lane), 32 characters out. The second lane's load ends 28 bytes past the start.
+OPENSEA_TARGET("avx2")
+static size_t base64_Encode_AVX2(const uint8_t *data, size_t dataLength, char *output)
+{
+    size_t offset = 0;
+    for (; offset + 28 <= dataLength; offset += 24, output += 32)
+    {
+        __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)&data[offset])), _mm_loadu_si128((const __m128i*)&data[offset + 12]), 1);
+        _mm256_storeu_si256((__m256i*)output, base64_Characters_AVX2(input));
+    }
+    return offset;
+}
+
+//16 characters in, 12 bytes out, but 16 bytes are stored. Character validation uses the nibble lookup tables from Wojciech Mula's base64 decoder.
+//Stops at the first block with a character outside the alphabet so that the scalar code can report it.
+OPENSEA_TARGET("ssse3")
+static size_t base64_Decode_SSSE3(const char *base64, size_t characterCount, uint8_t *output)
+{
+    const __m128i lowNibbleTable = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i highNibbleTable = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i rollTable = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    size_t offset = 0;
+    //24 characters must be left so the 4 extra bytes stored land on output that is written later
+    for (; offset + 24 <= characterCount; offset += 16, output += 12)
+    {
+        __m128i characters = _mm_loadu_si128((const __m128i*)&base64[offset]);
+        __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(characters, 4), nibbleMask);
+        __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lowNibbleTable, _mm_and_si128(characters, nibbleMask)), _mm_shuffle_epi8(highNibbleTable, highNibbles));
+        __m128i values;
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+        values = _mm_add_epi8(characters, _mm_shuffle_epi8(rollTable, _mm_add_epi8(_mm_cmpeq_epi8(characters, _mm_set1_epi8('/')), highNibbles)));
+        //merge pairs of 6bit values into 12bits, then pairs of those into 24bits, then pull out the 3 bytes of each
+        values = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        values = _mm_madd_epi16(values, _mm_set1_epi32(0x00011000));
+        values = _mm_shuffle_epi8(values, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128((__m128i*)output, values);
+    }
+    return offset;
+}
+
+//32 characters in, 24 bytes out, but 32 bytes are stored
+OPENSEA_TARGET("avx2")
+static size_t base64_Decode_AVX2(const char *base64, size_t characterCount, uint8_t *output)
+{
+    const __m256i lowNibbleTable = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+    const __m256i highNibbleTable = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+    const __m256i rollTable = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    size_t offset = 0;
+    //44 characters must be left so the 8 extra bytes stored land on output that is written later
+    for (; offset + 44 <= characterCount; offset += 32, output += 24)
+    {
+        __m256i characters = _mm256_loadu_si256((const __m256i*)&base64[offset]);
+        __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(characters, 4), nibbleMask);
+        __m256i invalid = _mm256_and_si256(_mm256_shuffle_epi8(lowNibbleTable, _mm256_and_si256(characters, nibbleMask)), _mm256_shuffle_epi8(highNibbleTable, highNibbles));
+        __m256i values;
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(invalid, _mm256_setzero_si256())) != -1)
+        {
+            break;
+        }
+        values = _mm256_add_epi8(characters, _mm256_shuffle_epi8(rollTable, _mm256_add_epi8(_mm256_cmpeq_epi8(characters, _mm256_set1_epi8('/')), highNibbles)));
+        values = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        values = _mm256_madd_epi16(values, _mm256_set1_epi32(0x00011000));
+        values = _mm256_shuffle_epi8(values, _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+        //each lane now has 12 bytes at the bottom, so move them next to each other
+        values = _mm256_permutevar8x32_epi32(values, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256((__m256i*)output, values);
+    }
+    return offset;
+}
+#elif defined (OPENSEA_ENCODE_NEON)
+//16 bytes in, 32 characters out. vst2 interleaves the high and low nibble characters.
+static size_t hex_Encode_NEON(const uint8_t *data, size_t dataLength, char *output, const char *digits)
+{
+    const uint8x16_t digitTable = vld1q_u8((const uint8_t*)digits);
+    size_t offset = 0;
+    for (; offset + 16 <= dataLength; offset += 16)
+    {
+        uint8x16_t bytes = vld1q_u8(&data[offset]);
+        uint8x16x2_t characters;
+        characters.val[0] = vqtbl1q_u8(digitTable, vshrq_n_u8(bytes, 4));
+        characters.val[1] = vqtbl1q_u8(digitTable, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+        vst2q_u8((uint8_t*)&output[offset * 2], characters);
+    }
+    return offset;
+}
+
+static uint8x16_t hex_Digit_Values_NEON(uint8x16_t characters, uint8x16_t *valid)
+{
+    uint8x16_t digits = vsubq_u8(characters, vdupq_n_u8('0'));
+    uint8x16_t letters = vsubq_u8(vorrq_u8(characters, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t isDigit = vcltq_u8(digits, vdupq_n_u8(10));
+    uint8x16_t isLetter = vcltq_u8(letters, vdupq_n_u8(6));
+    *valid = vandq_u8(*valid, vorrq_u8(isDigit, isLetter));
+    return vorrq_u8(vandq_u8(isDigit, digits), vandq_u8(isLetter, vaddq_u8(letters, vdupq_n_u8(10))));
+}
+
+//32 characters in, 16 bytes out. vld2 splits the high and low nibble characters.
+static size_t hex_Decode_NEON(const char *hex, size_t byteCount, uint8_t *output)
+{
+    size_t offset = 0;
+    for (; offset + 16 <= byteCount; offset += 16)
+    {
+        uint8x16x2_t characters = vld2q_u8((const uint8_t*)&hex[offset * 2]);
+        uint8x16_t valid = vdupq_n_u8(0xFF);
+        uint8x16_t high = hex_Digit_Values_NEON(characters.val[0], &valid);
+        uint8x16_t low = hex_Digit_Values_NEON(characters.val[1], &valid);
+        if (vminvq_u8(valid) != 0xFF)
+        {
+            break;
+        }
+        vst1q_u8(&output[offset], vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    return offset;
+}
+
+//48 bytes in, 64 characters out. vld3 splits each group of 3 bytes and vst4 interleaves the 4 characters made from them.
+static size_t base64_Encode_NEON(const uint8_t *data, size_t dataLength, char *output)
+{
+    uint8x16x4_t alphabet;
+    size_t offset = 0;
+    alphabet.val[0] = vld1q_u8((const uint8_t*)&base64Alphabet[0]);
+    alphabet.val[1] = vld1q_u8((const uint8_t*)&base64Alphabet[16]);
+    alphabet.val[2] = vld1q_u8((const uint8_t*)&base64Alphabet[32]);
+    alphabet.val[3] = vld1q_u8((const uint8_t*)&base64Alphabet[48]);
+    for (; offset + 48 <= dataLength; offset += 48, output += 64)
+    {
+        uint8x16x3_t bytes = vld3q_u8(&data[offset]);
+        uint8x16x4_t characters;
+        characters.val[0] = vshrq_n_u8(bytes.val[0], 2);
+        characters.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(bytes.val[0], vdupq_n_u8(0x03)), 4), vshrq_n_u8(bytes.val[1], 4));
+        characters.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(bytes.val[1], vdupq_n_u8(0x0F)), 2), vshrq_n_u8(bytes.val[2], 6));
+        characters.val[3] = vandq_u8(bytes.val[2], vdupq_n_u8(0x3F));
+        characters.val[0] = vqtbl4q_u8(alphabet, characters.val[0]);
+        characters.val[1] = vqtbl4q_u8(alphabet, characters.val[1]);
+        characters.val[2] = vqtbl4q_u8(alphabet, characters.val[2]);
+        characters.val[3] = vqtbl4q_u8(alphabet, characters.val[3]);
+        vst4q_u8((uint8_t*)output, characters);
+    }
+    return offset;
+}
+
+static uint8x16_t base64_Character_Values_NEON(uint8x16_t characters, uint8x16_t *valid)
+{
+    uint8x16_t upper = vsubq_u8(characters, vdupq_n_u8('A'));
+    uint8x16_t lower = vsubq_u8(characters, vdupq_n_u8('a'));
+    uint8x16_t digit = vsubq_u8(characters, vdupq_n_u8('0'));
+    uint8x16_t isUpper = vcltq_u8(upper, vdupq_n_u8(26));
+    uint8x16_t isLower = vcltq_u8(lower, vdupq_n_u8(26));
+    uint8x16_t isDigit = vcltq_u8(digit, vdupq_n_u8(10));
+    uint8x16_t isPlus = vceqq_u8(characters, vdupq_n_u8('+'));
+    uint8x16_t isSlash = vceqq_u8(characters, vdupq_n_u8('/'));
+    uint8x16_t values = vandq_u8(isUpper, upper);
+    values = vorrq_u8(values, vandq_u8(isLower, vaddq_u8(lower, vdupq_n_u8(26))));
+    values = vorrq_u8(values, vandq_u8(isDigit, vaddq_u8(digit, vdupq_n_u8(52))));
+    values = vorrq_u8(values, vandq_u8(isPlus, vdupq_n_u8(62)));
+    values = vorrq_u8(values, vandq_u8(isSlash, vdupq_n_u8(63)));
+    *valid = vandq_u8(*valid, vorrq_u8(vorrq_u8(vorrq_u8(isUpper, isLower), vorrq_u8(isDigit, isPlus)), isSlash));
+    return values;
+}
+
+//64 characters in, 48 bytes out
+static size_t base64_Decode_NEON(const char *base64, size_t characterCount, uint8_t *output)
+{
+    size_t offset = 0;
+    for (; offset + 64 <= characterCount; offset += 64, output += 48)
+    {
+        uint8x16x4_t characters = vld4q_u8((const uint8_t*)&base64[offset]);
+        uint8x16x3_t bytes;
+        uint8x16_t valid = vdupq_n_u8(0xFF);
+        uint8x16_t value0 = base64_Character_Values_NEON(characters.val[0], &valid);
+        uint8x16_t value1 = base64_Character_Values_NEON(characters.val[1], &valid);
+        uint8x16_t value2 = base64_Character_Values_NEON(characters.val[2], &valid);
+        uint8x16_t value3 = base64_Character_Values_NEON(characters.val[3], &valid);
+        if (vminvq_u8(valid) != 0xFF)
+        {
+            break;
+        }
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(value0, 2), vshrq_n_u8(value1, 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(value1, 4), vshrq_n_u8(value2, 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(value2, 6), value3);
+        vst3q_u8(output, bytes);
+    }
+    return offset;
+}
+#endif
+
+int hex_Encode(const uint8_t *data, size_t dataLength, char *output, size_t outputSize, bool upperCase)
+{
+    const char *digits = upperCase ? hexDigitsUpper : hexDigitsLower;
+    size_t processed = 0;
+#if defined (OPENSEA_CPU_X86)
+    uint64_t features = get_CPU_Features();
+#endif
+    if ((!data && dataLength > 0) || !output || dataLength > SIZE_MAX / 2 || outputSize < HEX_ENCODED_LENGTH(dataLength))
+    {
+        return BAD_PARAMETER;
+    }
+#if defined (OPENSEA_CPU_X86)
+    if (features & CPU_FEATURE_AVX2)
+    {
+        processed = hex_Encode_AVX2(data, dataLength, output, digits);
+    }
+    if (features & CPU_FEATURE_SSSE3)
+    {
+        processed += hex_Encode_SSSE3(&data[processed], dataLength - processed, &output[processed * 2], digits);
+    }
+#elif defined (OPENSEA_ENCODE_NEON)
+    processed = hex_Encode_NEON(data, dataLength, output, digits);
+#endif
+    hex_Encode_Scalar(&data[processed], dataLength - processed, &output[processed * 2], digits);
+    if (outputSize > HEX_ENCODED_LENGTH(dataLength))
+    {
+        output[HEX_ENCODED_LENGTH(dataLength)] = '\0';
+    }
+    return SUCCESS;
+}
+
+int hex_Decode(const char *hex, size_t hexLength, uint8_t *output, size_t outputSize)
+{
+    size_t byteCount = hexLength / 2;
+    size_t processed = 0;
+#if defined (OPENSEA_CPU_X86)
+    uint64_t features = get_CPU_Features();
+#endif
+    if ((!hex && hexLength > 0) || (!output && byteCount > 0) || (hexLength % 2) != 0 || outputSize < byteCount)
+    {
+        return BAD_PARAMETER;
+    }
+#if defined (OPENSEA_CPU_X86)
+    if (features & CPU_FEATURE_AVX2)
+    {
+        processed = hex_Decode_AVX2(hex, byteCount, output);
+    }
+    if (features & CPU_FEATURE_SSSE3)
+    {
+        processed += hex_Decode_SSSE3(&hex[processed * 2], byteCount - processed, &output[processed]);
+    }
+#elif defined (OPENSEA_ENCODE_NEON)
+    processed = hex_Decode_NEON(hex, byteCount, output);
+#endif
+    return hex_Decode_Scalar(&hex[processed * 2], byteCount - processed, &output[processed]);
+}
+
+int base64_Encode(const uint8_t *data, size_t dataLength, char *output, size_t outputSize)
+{
+    size_t wholeGroupLength = (dataLength / 3) * 3;
+    size_t processed = 0;
+    size_t remaining = 0;
+    char *finalGroup = NULL;
+#if defined (OPENSEA_CPU_X86)
+    uint64_t features = get_CPU_Features();
+#endif
+    if ((!data && dataLength > 0) || !output || dataLength / 3 >= SIZE_MAX / 4 || outputSize < BASE64_ENCODED_LENGTH(dataLength))
+    {
+        return BAD_PARAMETER;
+    }
+    //The kernels only read whole groups of 3, so the final partial group is never touched by them
+#if defined (OPENSEA_CPU_X86)
+    if (features & CPU_FEATURE_AVX2)
+    {
+        processed = base64_Encode_AVX2(data, wholeGroupLength, output);
+    }
+    if (features & CPU_FEATURE_SSSE3)
+    {
+        processed += base64_Encode_SSSE3(&data[processed], wholeGroupLength - processed, &output[(processed / 3) * 4]);
+    }
+#elif defined (OPENSEA_ENCODE_NEON)
+    processed = base64_Encode_NEON(data, wholeGroupLength, output);
+#endif
+    base64_Encode_Scalar(&data[processed], wholeGroupLength - processed, &output[(processed / 3) * 4]);
+    remaining = dataLength - wholeGroupLength;
+    finalGroup = &output[(wholeGroupLength / 3) * 4];
+    if (remaining > 0)
+    {
+        uint32_t group = (uint32_t)data[wholeGroupLength] << 16;
+        if (remaining == 2)
+        {
+            group |= (uint32_t)data[wholeGroupLength + 1] << 8;
+        }
+        finalGroup[0] = base64Alphabet[(group >> 18) & 0x3F];
+        finalGroup[1] = base64Alphabet[(group >> 12) & 0x3F];
+        finalGroup[2] = remaining == 2 ? base64Alphabet[(group >> 6) & 0x3F] : '=';
+        finalGroup[3] = '=';
+    }
+    if (outputSize > BASE64_ENCODED_LENGTH(dataLength))
+    {
+        output[BASE64_ENCODED_LENGTH(dataLength)] = '\0';
+    }
+    return SUCCESS;
+}
+
+int base64_Decode(const char *base64, size_t base64Length, uint8_t *output, size_t outputSize, size_t *decodedLength)
+{
+    size_t characterCount = base64Length;
+    size_t wholeGroupCharacters = 0;
+    size_t totalLength = 0;
+    size_t processed = 0;
+    int ret = SUCCESS;
+#if defined (OPENSEA_CPU_X86)
+    uint64_t features = get_CPU_Features();
+#endif
+    if ((!base64 && base64Length > 0) || !decodedLength)
+    {
+        return BAD_PARAMETER;
+    }
+    *decodedLength = 0;
+    //padding is only allowed to fill out the last group of 4
+    if (base64Length > 0 && base64Length % 4 == 0 && base64[base64Length - 1] == '=')
+    {
+        --characterCount;
+        if (base64[base64Length - 2] == '=')
+        {
+            --characterCount;
+        }
+    }
+    if (characterCount % 4 == 1)
+    {
+        return FAILURE;
+    }
+    wholeGroupCharacters = (characterCount / 4) * 4;
+    totalLength = (wholeGroupCharacters / 4) * 3 + (characterCount % 4 == 0 ? 0 : (characterCount % 4) - 1);
+    if ((!output && totalLength > 0) || outputSize < totalLength)
+    {
+        return BAD_PARAMETER;
+    }
+#if defined (OPENSEA_CPU_X86)
+    if (features & CPU_FEATURE_AVX2)
+    {
+        processed = base64_Decode_AVX2(base64, wholeGroupCharacters, output);
+    }
+    if (features & CPU_FEATURE_SSSE3)
+    {
+        processed += base64_Decode_SSSE3(&base64[processed], wholeGroupCharacters - processed, &output[(processed / 4) * 3]);
+    }
+#elif defined (OPENSEA_ENCODE_NEON)
+    processed = base64_Decode_NEON(base64, wholeGroupCharacters, output);
+#endif
+    ret = base64_Decode_Scalar(&base64[processed], wholeGroupCharacters - processed, &output[(processed / 4) * 3]);
+    if (ret == SUCCESS && characterCount > wholeGroupCharacters)
+    {
+        //final group of 2 or 3 characters making 1 or 2 bytes
+        const char *finalGroup = &base64[wholeGroupCharacters];
+        uint8_t *finalOutput = &output[(wholeGroupCharacters / 4) * 3];
+        uint8_t value0 = base64_Character_Value(finalGroup[0]);
+        uint8_t value1 = base64_Character_Value(finalGroup[1]);
+        uint8_t value2 = characterCount - wholeGroupCharacters == 3 ? base64_Character_Value(finalGroup[2]) : 0;
+        if ((value0 | value1 | value2) & 0xC0)
+        {
+            return FAILURE;
+        }
+        finalOutput[0] = (uint8_t)((value0 << 2) | (value1 >> 4));
+        if (characterCount - wholeGroupCharacters == 3)
+        {
+            finalOutput[1] = (uint8_t)((value1 << 4) | (value2 >> 2));
+        }
+    }
+    if (ret == SUCCESS)
+    {
+        *decodedLength = totalLength;
+    }
+    return ret;
+}
@@ -0,0 +1,499 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_hash.c
+// \brief Implements fast non-cryptographic 64 and 128 bit hashes of data buffers, for finding duplicate or changed data
+//
+#include "common_hash.h"
+
+#if defined (OPENSEA_CPU_X86)
+#include <immintrin.h>
+#elif (defined (__aarch64__) && !defined (__AARCH64EB__)) || defined (_M_ARM64)
+#define OPENSEA_HASH_NEON
+#include <arm_neon.h>
+#endif
+
+#define HASH_PRIME_32 UINT32_C(0x9E3779B1)
+#define HASH_PRIME_64_1 UINT64_C(0x9E3779B185EBCA87)
+#define HASH_PRIME_64_2 UINT64_C(0xC2B2AE3D27D4EB4F)
+#define HASH_PRIME_64_3 UINT64_C(0x165667B19E3779F9)
+#define HASH_PRIME_64_4 UINT64_C(0x85EBCA77C2B2AE63)
+#define HASH_PRIME_64_5 UINT64_C(0x27D4EB2F165667C5)
+#define HASH_REMIX_MULTIPLIER UINT64_C(0x9FB21C651E98DF25)
+
+//Long inputs: the stripes of a block use secret words N to N + 7 for stripe N, then the accumulators are scrambled with the words after that.
+//The last stripe and the final merges use their own words, so every part of the hash gets different keys.
+#define HASH_STRIPES_PER_BLOCK 16
+#define HASH_SCRAMBLE_SECRET HASH_STRIPES_PER_BLOCK
+#define HASH_LAST_STRIPE_SECRET 13
+#define HASH_MERGE_LOW_SECRET 3
+#define HASH_MERGE_HIGH_SECRET 11
+#define HASH_SHORT_HIGH_SECRET 8 //short inputs use the secret from here for the high half of a 128 bit hash
+
+//first HASH_SECRET_WORDS values of splitmix64 seeded with 0. A seed is added to the even words and subtracted from the odd ones.
+static const uint64_t hashDefaultSecret[HASH_SECRET_WORDS] = {
+    UINT64_C(0xE220A8397B1DCDAF), UINT64_C(0x6E789E6AA1B965F4), UINT64_C(0x06C45D188009454F), UINT64_C(0xF88BB8A8724C81EC),
+    UINT64_C(0x1B39896A51A8749B), UINT64_C(0x53CB9F0C747EA2EA), UINT64_C(0x2C829ABE1F4532E1), UINT64_C(0xC584133AC916AB3C),
+    UINT64_C(0x3EE5789041C98AC3), UINT64_C(0xF3B8488C368CB0A6), UINT64_C(0x657EECDD3CB13D09), UINT64_C(0xC2D326E0055BDEF6),
+    UINT64_C(0x8621A03FE0BBDB7B), UINT64_C(0x8E1F7555983AA92F), UINT64_C(0xB54E0F1600CC4D19), UINT64_C(0x84BB3F97971D80AB),
+    UINT64_C(0x7D29825C75521255), UINT64_C(0xC3CF17102B7F7F86), UINT64_C(0x3466E9A083914F64), UINT64_C(0xD81A8D2B5A4485AC),
+    UINT64_C(0xDB01602B100B9ED7), UINT64_C(0xA9038A921825F10D), UINT64_C(0xEDF5F1D90DCA2F6A), UINT64_C(0x54496AD67BD2634C)
+};
+
+static uint64_t get_Secret_Word(uint64_t seed, uint8_t index)
+{
+    return (index & 1) ? hashDefaultSecret[index] - seed : hashDefaultSecret[index] + seed;
+}
+
+static void make_Hash_Secret(uint64_t seed, uint64_t *secret)
+{
+    for (uint8_t index = 0; index < HASH_SECRET_WORDS; ++index)
+    {
+        secret[index] = get_Secret_Word(seed, index);
+    }
+}
+
+//full 128bit product folded down to 64 bits. Short inputs are mostly this, so the compiler's 128bit type is used directly when there is one.
+static uint64_t multiply_Fold_64(uint64_t value1, uint64_t value2)
+{
+#if defined (__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)value1 * value2;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    uint64_t high = 0;
+    uint64_t low = multiply_64_To_128(value1, value2, &high);
+    return low ^ high;
+#endif
+}
+
+static uint64_t hash_Avalanche(uint64_t hash)
+{
+    hash ^= hash >> 37;
+    hash *= HASH_PRIME_64_3;
+    return hash ^ (hash >> 32);
+}
+
+//stronger mix for the 1 to 8 byte inputs, which have had no multiply yet
+static uint64_t hash_Remix(uint64_t hash, uint64_t length)
+{
+    hash ^= rotate_Left_64(hash, 49) ^ rotate_Left_64(hash, 24);
+    hash *= HASH_REMIX_MULTIPLIER;
+    hash ^= (hash >> 35) + length;
+    hash *= HASH_REMIX_MULTIPLIER;
+    return hash ^ (hash >> 28);
+}
+
+static uint64_t mix_16_Bytes(const uint8_t *data, uint64_t seed, uint8_t secretIndex)
+{
+    return multiply_Fold_64(load_Little_Endian_64(data) ^ get_Secret_Word(seed, secretIndex), load_Little_Endian_64(data + 8) ^ get_Secret_Word(seed, secretIndex + 1));
+}
+
+//up to HASH_SHORT_LENGTH bytes. secretIndex is 0 for a 64bit hash or the low half of a 128bit hash, HASH_SHORT_HIGH_SECRET for the high half.
+static uint64_t hash_Short(uint64_t seed, const uint8_t *data, size_t length, uint8_t secretIndex)
+{
+    if (length > 16)
+    {
+        //pairs of 16 byte pieces from the front and back meet in the middle, so every byte is mixed in
+        uint64_t hash = length * HASH_PRIME_64_1;
+        size_t rounds = (length + 31) / 32;
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            hash += mix_16_Bytes(data + round * 16, seed, (uint8_t)(secretIndex + round * 4));
+            hash += mix_16_Bytes(data + length - (round + 1) * 16, seed, (uint8_t)(secretIndex + round * 4 + 2));
+        }
+        return hash_Avalanche(hash);
+    }
+    else if (length > 8)
+    {
+        uint64_t low = load_Little_Endian_64(data) ^ get_Secret_Word(seed, secretIndex);
+        uint64_t high = load_Little_Endian_64(data + length - 8) ^ get_Secret_Word(seed, secretIndex + 1);
+        return hash_Avalanche(length + rotate_Left_64(low, 29) + high + multiply_Fold_64(low, high));
+    }
+    else if (length >= 4)
+    {
+        uint64_t input = load_Little_Endian_32(data) | ((uint64_t)load_Little_Endian_32(data + length - 4) << 32);
+        return hash_Remix(input ^ get_Secret_Word(seed, secretIndex) ^ rotate_Left_64(get_Secret_Word(seed, secretIndex + 1), 32), length);
+    }
+    else if (length > 0)
+    {
+        uint64_t input = ((uint64_t)data[0] << 16) | ((uint64_t)data[length >> 1] << 24) | data[length - 1] | ((uint64_t)length << 8);
+        return hash_Remix(input ^ get_Secret_Word(seed, secretIndex), length);
+    }
+    else
+    {
+        return hash_Avalanche(seed ^ get_Secret_Word(seed, secretIndex) ^ get_Secret_Word(seed, secretIndex + 1));
+    }
+}
+
+static void init_Hash_Accumulators(uint64_t *accumulators)
+{
+    accumulators[0] = UINT32_C(0xC2B2AE3D);
+    accumulators[1] = HASH_PRIME_64_1;
+    accumulators[2] = HASH_PRIME_64_2;
+    accumulators[3] = HASH_PRIME_64_3;
+    accumulators[4] = HASH_PRIME_64_4;
+    accumulators[5] = UINT32_C(0x85EBCA77);
+    accumulators[6] = HASH_PRIME_64_5;
+    accumulators[7] = HASH_PRIME_32;
+}
+
+//Each lane adds the product of the two halves of its keyed data, and the unkeyed data of its neighbour so no data is lost when a product is 0.
+//Stripe N of the list uses secret words N to N + 7.
+static void accumulate_Stripes_Scalar(uint64_t *accumulators, const uint8_t *data, size_t stripeCount, const uint64_t *secret)
+{
+    for (size_t stripe = 0; stripe < stripeCount; ++stripe, data += HASH_STRIPE_SIZE, ++secret)
+    {
+        for (uint8_t lane = 0; lane < HASH_LANES; ++lane)
+        {
+            uint64_t value = load_Little_Endian_64(data + lane * 8);
+            uint64_t keyed = value ^ secret[lane];
+            accumulators[lane ^ 1] += value;
+            accumulators[lane] += (keyed & UINT32_MAX) * (keyed >> 32);
+        }
+    }
+}
+
+static void scramble_Accumulators_Scalar(uint64_t *accumulators, const uint64_t *secret)
+{
+    for (uint8_t lane = 0; lane < HASH_LANES; ++lane)
+    {
+        uint64_t value = accumulators[lane];
+        value ^= value >> 47;
+        value ^= secret[lane];
+        accumulators[lane] = value * HASH_PRIME_32;
+    }
+}
+
+#if defined (OPENSEA_CPU_X86)
+//AVX2 only multiplies 32bit halves, which is all the stripes need. The scramble's 64 by 32 bit multiply is done as two of them.
+OPENSEA_TARGET("avx2")
+static void accumulate_Stripes_AVX2(uint64_t *accumulators, const uint8_t *data, size_t stripeCount, const uint64_t *secret)
+{
+    __m256i low = _mm256_loadu_si256((const __m256i*)&accumulators[0]);
+    __m256i high = _mm256_loadu_si256((const __m256i*)&accumulators[4]);
+    for (size_t stripe = 0; stripe < stripeCount; ++stripe, data += HASH_STRIPE_SIZE, ++secret)
+    {
+        __m256i lowData = _mm256_loadu_si256((const __m256i*)data);
+        __m256i highData = _mm256_loadu_si256((const __m256i*)(data + 32));
+        __m256i lowKeyed = _mm256_xor_si256(lowData, _mm256_loadu_si256((const __m256i*)&secret[0]));
+        __m256i highKeyed = _mm256_xor_si256(highData, _mm256_loadu_si256((const __m256i*)&secret[4]));
+        __m256i lowProduct = _mm256_mul_epu32(lowKeyed, _mm256_srli_epi64(lowKeyed, 32));
+        __m256i highProduct = _mm256_mul_epu32(highKeyed, _mm256_srli_epi64(highKeyed, 32));
+        //swap each pair of 64bit lanes to add the neighbour's data
+        low = _mm256_add_epi64(low, _mm256_add_epi64(lowProduct, _mm256_shuffle_epi32(lowData, _MM_SHUFFLE(1, 0, 3, 2))));
+        high = _mm256_add_epi64(high, _mm256_add_epi64(highProduct, _mm256_shuffle_epi32(highData, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+    _mm256_storeu_si256((__m256i*)&accumulators[0], low);
+    _mm256_storeu_si256((__m256i*)&accumulators[4], high);
+}
+
+OPENSEA_TARGET("avx2")
+static void scramble_Accumulators_AVX2(uint64_t *accumulators, const uint64_t *secret)
+{
+    __m256i prime = _mm256_set1_epi32((int)HASH_PRIME_32);
+    for (uint8_t lane = 0; lane < HASH_LANES; lane += 4)
+    {
+        __m256i value = _mm256_loadu_si256((const __m256i*)&accumulators[lane]);
+        value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+        value = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*)&secret[lane]));
+        value = _mm256_add_epi64(_mm256_mul_epu32(value, prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime), 32));
+        _mm256_storeu_si256((__m256i*)&accumulators[lane], value);
+    }
+}
+#elif defined (OPENSEA_HASH_NEON)
+static void accumulate_Stripes_NEON(uint64_t *accumulators, const uint8_t *data, size_t stripeCount, const uint64_t *secret)
+{
+    uint64x2_t lanes[4];
+    for (uint8_t set = 0; set < 4; ++set)
+    {
+        lanes[set] = vld1q_u64(&accumulators[set * 2]);
+    }
+    for (size_t stripe = 0; stripe < stripeCount; ++stripe, data += HASH_STRIPE_SIZE, ++secret)
+    {
+        for (uint8_t set = 0; set < 4; ++set)
+        {
+            uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(data + set * 16));
+            uint64x2_t keyed = veorq_u64(value, vld1q_u64(&secret[set * 2]));
+            uint64x2_t product = vmull_u32(vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+            lanes[set] = vaddq_u64(lanes[set], vaddq_u64(product, vextq_u64(value, value, 1)));
+        }
+    }
+    for (uint8_t set = 0; set < 4; ++set)
+    {
+        vst1q_u64(&accumulators[set * 2], lanes[set]);
+    }
+}
+
+static void scramble_Accumulators_NEON(uint64_t *accumulators, const uint64_t *secret)
+{
+    for (uint8_t set = 0; set < 4; ++set)
+    {
+        uint64x2_t value = vld1q_u64(&accumulators[set * 2]);
+        value = veorq_u64(value, vshrq_n_u64(value, 47));
+        value = veorq_u64(value, vld1q_u64(&secret[set * 2]));
+        value = vaddq_u64(vmull_n_u32(vmovn_u64(value), HASH_PRIME_32), vshlq_n_u64(vmull_n_u32(vshrn_n_u64(value, 32), HASH_PRIME_32), 32));
+        vst1q_u64(&accumulators[set * 2], value);
+    }
+}
+#endif
+
+static void accumulate_Stripes(uint64_t *accumulators, const uint8_t *data, size_t stripeCount, const uint64_t *secret)
+{
+#if defined (OPENSEA_CPU_X86)
+    if (get_CPU_Features() & CPU_FEATURE_AVX2)
+    {
+        accumulate_Stripes_AVX2(accumulators, data, stripeCount, secret);
+        return;
+    }
+#elif defined (OPENSEA_HASH_NEON)
+    accumulate_Stripes_NEON(accumulators, data, stripeCount, secret);
+    return;
+#endif
+    accumulate_Stripes_Scalar(accumulators, data, stripeCount, secret);
+}
+
+static void scramble_Accumulators(uint64_t *accumulators, const uint64_t *secret)
+{
+#if defined (OPENSEA_CPU_X86)
+    if (get_CPU_Features() & CPU_FEATURE_AVX2)
+    {
+        scramble_Accumulators_AVX2(accumulators, secret);
+        return;
+    }
+#elif defined (OPENSEA_HASH_NEON)
+    scramble_Accumulators_NEON(accumulators, secret);
+    return;
+#endif
+    scramble_Accumulators_Scalar(accumulators, secret);
+}
+
+//adds whole stripes, scrambling after every HASH_STRIPES_PER_BLOCK. stripesInBlock carries the position in the block between calls.
+static void accumulate_Blocks(uint64_t *accumulators, uint32_t *stripesInBlock, const uint64_t *secret, const uint8_t *data, size_t stripeCount)
+{
+    while (stripeCount > 0)
+    {
+        size_t stripes = M_Min(stripeCount, (size_t)(HASH_STRIPES_PER_BLOCK - *stripesInBlock));
+        accumulate_Stripes(accumulators, data, stripes, &secret[*stripesInBlock]);
+        data += stripes * HASH_STRIPE_SIZE;
+        stripeCount -= stripes;
+        *stripesInBlock += (uint32_t)stripes;
+        if (*stripesInBlock == HASH_STRIPES_PER_BLOCK)
+        {
+            scramble_Accumulators(accumulators, &secret[HASH_SCRAMBLE_SECRET]);
+            *stripesInBlock = 0;
+        }
+    }
+}
+
+static uint64_t merge_Accumulators(const uint64_t *accumulators, const uint64_t *secret, uint64_t start)
+{
+    uint64_t hash = start;
+    for (uint8_t lane = 0; lane < HASH_LANES; lane += 2)
+    {
+        hash += multiply_Fold_64(accumulators[lane] ^ secret[lane], accumulators[lane + 1] ^ secret[lane + 1]);
+    }
+    return hash_Avalanche(hash);
+}
+
+//Accumulates data longer than HASH_SHORT_LENGTH. The last stripe is always the final HASH_STRIPE_SIZE bytes (overlapping the stripe before it
+//when the length is not a multiple of the stripe size) and is never part of a block, so the streaming state only needs to hold that much back.
+static void hash_Long(const uint64_t *secret, const uint8_t *data, size_t length, uint64_t *accumulators)
+{
+    uint32_t stripesInBlock = 0;
+    init_Hash_Accumulators(accumulators);
+    accumulate_Blocks(accumulators, &stripesInBlock, secret, data, (length - 1) / HASH_STRIPE_SIZE);
+    accumulate_Stripes(accumulators, data + length - HASH_STRIPE_SIZE, 1, &secret[HASH_LAST_STRIPE_SECRET]);
+}
+
+uint64_t hash_Buffer_64(uint64_t seed, const void *data, size_t length)
+{
+    if (length <= HASH_SHORT_LENGTH)
+    {
+        return hash_Short(seed, (const uint8_t*)data, length, 0);
+    }
+    else
+    {
+        uint64_t secret[HASH_SECRET_WORDS];
+        uint64_t accumulators[HASH_LANES];
+        make_Hash_Secret(seed, secret);
+        hash_Long(secret, (const uint8_t*)data, length, accumulators);
+        return merge_Accumulators(accumulators, &secret[HASH_MERGE_LOW_SECRET], length * HASH_PRIME_64_1);
+    }
+}
+
+hash128 hash_Buffer_128(uint64_t seed, const void *data, size_t length)
+{
+    hash128 hash;
+    if (length <= HASH_SHORT_LENGTH)
+    {
+        hash.low = hash_Short(seed, (const uint8_t*)data, length, 0);
+        hash.high = hash_Short(seed, (const uint8_t*)data, length, HASH_SHORT_HIGH_SECRET);
+    }
+    else
+    {
+        uint64_t secret[HASH_SECRET_WORDS];
+        uint64_t accumulators[HASH_LANES];
+        make_Hash_Secret(seed, secret);
+        hash_Long(secret, (const uint8_t*)data, length, accumulators);
+        hash.low = merge_Accumulators(accumulators, &secret[HASH_MERGE_LOW_SECRET], length * HASH_PRIME_64_1);
+        hash.high = merge_Accumulators(accumulators, &secret[HASH_MERGE_HIGH_SECRET], ~(length * HASH_PRIME_64_2));
+    }
+    return hash;
+}
+
+void init_Hash_State(ptrHashState state, uint64_t seed)
+{
+    memset(state, 0, sizeof(hashState));
+    state->seed = seed;
+    make_Hash_Secret(seed, state->secret);
+    init_Hash_Accumulators(state->accumulators);
+}
+
+int update_Hash_State(ptrHashState state, const void *data, size_t length)
+{
+    const uint8_t *input = (const uint8_t*)data;
+    if (!state || (!data && length > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    state->totalLength += length;
+    if (length <= HASH_STATE_BUFFER_SIZE - state->bufferedLength)
+    {
+        if (length > 0)
+        {
+            memcpy(&state->buffer[state->bufferedLength], input, length);
+            state->bufferedLength += (uint32_t)length;
+        }
+        return SUCCESS;
+    }
+    //more data follows the buffer, so none of it can be the last stripe
+    if (state->bufferedLength > 0)
+    {
+        size_t fillLength = HASH_STATE_BUFFER_SIZE - state->bufferedLength;
+        memcpy(&state->buffer[state->bufferedLength], input, fillLength);
+        input += fillLength;
+        length -= fillLength;
+        accumulate_Blocks(state->accumulators, &state->stripesInBlock, state->secret, state->buffer, HASH_STATE_BUFFER_SIZE / HASH_STRIPE_SIZE);
+        memcpy(state->lastStripe, &state->buffer[HASH_STATE_BUFFER_SIZE - HASH_STRIPE_SIZE], HASH_STRIPE_SIZE);
+        state->bufferedLength = 0;
+    }
+    //large pieces are accumulated straight from the caller's data, holding back at least one byte
+    if (length > HASH_STATE_BUFFER_SIZE)
+    {
+        size_t stripes = (length - 1) / HASH_STRIPE_SIZE;
+        accumulate_Blocks(state->accumulators, &state->stripesInBlock, state->secret, input, stripes);
+        input += stripes * HASH_STRIPE_SIZE;
+        length -= stripes * HASH_STRIPE_SIZE;
+        memcpy(state->lastStripe, input - HASH_STRIPE_SIZE, HASH_STRIPE_SIZE);
+    }
+    memcpy(state->buffer, input, length);
+    state->bufferedLength = (uint32_t)length;
+    return SUCCESS;
+}
+
+//finishes the accumulators of a copy of the state for data longer than HASH_SHORT_LENGTH, the same way hash_Long does
+static void finish_Hash_State(const hashState *state, uint64_t *accumulators)
+{
+    uint8_t lastStripe[HASH_STRIPE_SIZE];
+    uint32_t stripesInBlock = state->stripesInBlock;
+    const uint8_t *lastStripeData = lastStripe;
+    memcpy(accumulators, state->accumulators, sizeof(state->accumulators));
+    accumulate_Blocks(accumulators, &stripesInBlock, state->secret, state->buffer, (state->bufferedLength - 1) / HASH_STRIPE_SIZE);
+    if (state->bufferedLength >= HASH_STRIPE_SIZE)
+    {
+        lastStripeData = &state->buffer[state->bufferedLength - HASH_STRIPE_SIZE];
+    }
+    else
+    {
+        //the last stripe starts in the data accumulated before the buffer
+        size_t earlierLength = HASH_STRIPE_SIZE - state->bufferedLength;
+        memcpy(lastStripe, &state->lastStripe[state->bufferedLength], earlierLength);
+        memcpy(&lastStripe[earlierLength], state->buffer, state->bufferedLength);
+    }
+    accumulate_Stripes(accumulators, lastStripeData, 1, &state->secret[HASH_LAST_STRIPE_SECRET]);
+}
+
+uint64_t get_Hash_State_64(const hashState *state)
+{
+    uint64_t accumulators[HASH_LANES];
+    if (state->totalLength <= HASH_SHORT_LENGTH)
+    {
+        return hash_Short(state->seed, state->buffer, (size_t)state->totalLength, 0);
+    }
+    finish_Hash_State(state, accumulators);
+    return merge_Accumulators(accumulators, &state->secret[HASH_MERGE_LOW_SECRET], state->totalLength * HASH_PRIME_64_1);
+}
+
+hash128 get_Hash_State_128(const hashState *state)
+{
+    hash128 hash;
+    uint64_t accumulators[HASH_LANES];
+    if (state->totalLength <= HASH_SHORT_LENGTH)
+    {
+        hash.low = hash_Short(state->seed, state->buffer, (size_t)state->totalLength, 0);
+        hash.high = hash_Short(state->seed, state->buffer, (size_t)state->totalLength, HASH_SHORT_HIGH_SECRET);
+        return hash;
+    }
+    finish_Hash_State(state, accumulators);
+    hash.low = merge_Accumulators(accumulators, &state->secret[HASH_MERGE_LOW_SECRET], state->totalLength * HASH_PRIME_64_1);
+    hash.high = merge_Accumulators(accumulators, &state->secret[HASH_MERGE_HIGH_SECRET], ~(state->totalLength * HASH_PRIME_64_2));
+    return hash;
+}
+
+static int hash_Segments(uint64_t seed, const hashSegment *segments, size_t segmentCount, hashState *state)
+{
+    if (!segments && segmentCount > 0)
+    {
+        return BAD_PARAMETER;
+    }
+    init_Hash_State(state, seed);
+    for (size_t segment = 0; segment < segmentCount; ++segment)
+    {
+        int ret = update_Hash_State(state, segments[segment].data, segments[segment].length);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+    }
+    return SUCCESS;
+}
+
+int hash_Segments_64(uint64_t seed, const hashSegment *segments, size_t segmentCount, uint64_t *hash)
+{
+    hashState state;
+    int ret = SUCCESS;
+    if (!hash)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = hash_Segments(seed, segments, segmentCount, &state);
+    if (ret == SUCCESS)
+    {
+        *hash = get_Hash_State_64(&state);
+    }
+    return ret;
+}
+
+int hash_Segments_128(uint64_t seed, const hashSegment *segments, size_t segmentCount, hash128 *hash)
+{
+    hashState state;
+    int ret = SUCCESS;
+    if (!hash)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = hash_Segments(seed, segments, segmentCount, &state);
+    if (ret == SUCCESS)
+    {
+        *hash = get_Hash_State_128(&state);
+    }
+    return ret;
+}
@@ -0,0 +1,322 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_histogram.c
+// \brief Implements a high dynamic range histogram for recording latencies and reporting their percentiles
+//
+#include "common_histogram.h"
+
+#if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_ARM64))
+#include <intrin.h>
+#endif
+
+//Layout of the counts: bucket 0 holds values 0 to subBucketCount - 1 one for one. Every bucket after that covers the next power of 2
+//with the upper half of its sub-buckets (the lower half would repeat the bucket before it), each sub-bucket twice as wide as the last bucket's.
+//So there are subBucketHalfCount counts per bucket, plus the lower half of bucket 0.
+
+//value must not be 0
+static uint8_t count_Leading_Zeros_64(uint64_t value)
+{
+#if defined (__GNUC__) || defined (__clang__)
+    return (uint8_t)__builtin_clzll(value);
+#elif defined (_MSC_VER) && (defined (_M_X64) || defined (_M_ARM64))
+    unsigned long highestBit = 0;
+    _BitScanReverse64(&highestBit, value);
+    return (uint8_t)(63 - highestBit);
+#else
+    uint8_t zeros = 0;
+    while ((value & BIT63) == 0)
+    {
+        value <<= 1;
+        ++zeros;
+    }
+    return zeros;
+#endif
+}
+
+static uint8_t get_Bucket_Index(const latencyHistogram *histogram, uint64_t value)
+{
+    //position of the highest bit, counting the sub-bucket bits as bucket 0
+    return (uint8_t)(64 - count_Leading_Zeros_64(value | histogram->subBucketMask) - (histogram->subBucketHalfCountMagnitude + 1));
+}
+
+static uint32_t get_Counts_Index(const latencyHistogram *histogram, uint64_t value)
+{
+    uint8_t bucketIndex = get_Bucket_Index(histogram, value);
+    uint32_t subBucketIndex = (uint32_t)(value >> bucketIndex);
+    return ((uint32_t)(bucketIndex + 1) << histogram->subBucketHalfCountMagnitude) + subBucketIndex - histogram->subBucketHalfCount;
+}
+
+//smallest value counted at an index, and how many values share that index
+static void get_Index_Range(const latencyHistogram *histogram, uint32_t index, uint64_t *lowestValue, uint64_t *rangeSize)
+{
+    uint32_t bucketIndex = index >> histogram->subBucketHalfCountMagnitude;
+    uint64_t subBucketIndex = (index & (histogram->subBucketHalfCount - 1)) + histogram->subBucketHalfCount;
+    if (bucketIndex == 0)
+    {
+        subBucketIndex -= histogram->subBucketHalfCount;
+    }
+    else
+    {
+        --bucketIndex;
+    }
+    *lowestValue = subBucketIndex << bucketIndex;
+    *rangeSize = UINT64_C(1) << bucketIndex;
+}
+
+static void record_Value_Count(ptrLatencyHistogram histogram, uint64_t value, uint64_t count)
+{
+    uint64_t countedValue = M_Min(value, histogram->highestTrackableValue);
+    histogram->counts[get_Counts_Index(histogram, countedValue)] += count;
+    histogram->totalCount += count;
+    if (value < histogram->minValue)
+    {
+        histogram->minValue = value;
+    }
+    if (value > histogram->maxValue)
+    {
+        histogram->maxValue = value;
+    }
+}
+
+int init_Latency_Histogram(ptrLatencyHistogram histogram, uint64_t highestTrackableValue, uint8_t significantDigits)
+{
+    uint64_t singleUnitResolutionLimit = 2;
+    uint8_t subBucketCountMagnitude = 0;
+    uint64_t smallestUntrackableValue = 0;
+    uint32_t bucketCount = 1;
+    if (!histogram)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(histogram, 0, sizeof(latencyHistogram));
+    if (highestTrackableValue == 0)
+    {
+        highestTrackableValue = HISTOGRAM_DEFAULT_HIGHEST_VALUE;
+    }
+    if (significantDigits == 0)
+    {
+        significantDigits = HISTOGRAM_DEFAULT_SIGNIFICANT_DIGITS;
+    }
+    if (significantDigits > HISTOGRAM_MAX_SIGNIFICANT_DIGITS || highestTrackableValue < 2)
+    {
+        return BAD_PARAMETER;
+    }
+    //every value below 2 * 10^digits gets its own count, which keeps the relative error of every bucket under 10^-digits
+    for (uint8_t digit = 0; digit < significantDigits; ++digit)
+    {
+        singleUnitResolutionLimit *= 10;
+    }
+    while ((UINT64_C(1) << subBucketCountMagnitude) < singleUnitResolutionLimit)
+    {
+        ++subBucketCountMagnitude;
+    }
+    smallestUntrackableValue = UINT64_C(1) << subBucketCountMagnitude;
+    while (smallestUntrackableValue <= highestTrackableValue)
+    {
+        ++bucketCount;
+        if (smallestUntrackableValue > UINT64_MAX / 2)
+        {
+            break;
+        }
+        smallestUntrackableValue <<= 1;
+    }
+    histogram->highestTrackableValue = highestTrackableValue;
+    histogram->significantDigits = significantDigits;
+    histogram->subBucketHalfCountMagnitude = (uint8_t)(subBucketCountMagnitude - 1);
+    histogram->subBucketHalfCount = UINT32_C(1) << histogram->subBucketHalfCountMagnitude;
+    histogram->subBucketMask = (UINT64_C(1) << subBucketCountMagnitude) - 1;
+    histogram->countsLength = (bucketCount + 1) * histogram->subBucketHalfCount;
+    histogram->counts = (uint64_t*)calloc(histogram->countsLength, sizeof(uint64_t));
+    if (!histogram->counts)
+    {
+        histogram->countsLength = 0;
+        return MEMORY_FAILURE;
+    }
+    histogram->minValue = UINT64_MAX;
+    return SUCCESS;
+}
+
+void free_Latency_Histogram(ptrLatencyHistogram histogram)
+{
+    if (histogram)
+    {
+        safe_Free(histogram->counts);
+        histogram->countsLength = 0;
+        histogram->totalCount = 0;
+    }
+}
+
+void reset_Latency_Histogram(ptrLatencyHistogram histogram)
+{
+    if (histogram && histogram->counts)
+    {
+        memset(histogram->counts, 0, histogram->countsLength * sizeof(uint64_t));
+        histogram->totalCount = 0;
+        histogram->minValue = UINT64_MAX;
+        histogram->maxValue = 0;
+    }
+}
+
+void record_Histogram_Value(ptrLatencyHistogram histogram, uint64_t value)
+{
+    if (histogram && histogram->counts)
+    {
+        record_Value_Count(histogram, value, 1);
+    }
+}
+
+void record_Histogram_Timer(ptrLatencyHistogram histogram, seatimer_t timer)
+{
+    record_Histogram_Value(histogram, get_Nano_Seconds(timer));
+}
+
+int merge_Latency_Histogram(ptrLatencyHistogram destination, const latencyHistogram *source)
+{
+    if (!destination || !destination->counts || !source || !source->counts)
+    {
+        return BAD_PARAMETER;
+    }
+    if (source->totalCount == 0)
+    {
+        return SUCCESS;
+    }
+    if (destination->subBucketHalfCountMagnitude == source->subBucketHalfCountMagnitude && destination->countsLength >= source->countsLength)
+    {
+        //same index for every value, so the counts just add up
+        for (uint32_t index = 0; index < source->countsLength; ++index)
+        {
+            destination->counts[index] += source->counts[index];
+        }
+        destination->totalCount += source->totalCount;
+        destination->minValue = M_Min(destination->minValue, source->minValue);
+        destination->maxValue = M_Max(destination->maxValue, source->maxValue);
+    }
+    else
+    {
+        for (uint32_t index = 0; index < source->countsLength; ++index)
+        {
+            if (source->counts[index] > 0)
+            {
+                uint64_t lowestValue = 0;
+                uint64_t rangeSize = 0;
+                get_Index_Range(source, index, &lowestValue, &rangeSize);
+                //the middle of the range can be outside of the values actually recorded, so keep the source's real min and max
+                record_Value_Count(destination, M_Max(M_Min(lowestValue + (rangeSize >> 1), source->maxValue), source->minValue), source->counts[index]);
+            }
+        }
+        //in case they were clamped into the destination's highest bucket
+        destination->maxValue = M_Max(destination->maxValue, source->maxValue);
+    }
+    return SUCCESS;
+}
+
+uint64_t get_Histogram_Percentile(const latencyHistogram *histogram, double percentile)
+{
+    uint64_t targetCount = 0;
+    uint64_t runningCount = 0;
+    if (!histogram || !histogram->counts || histogram->totalCount == 0)
+    {
+        return 0;
+    }
+    if (percentile <= 0.0)
+    {
+        return histogram->minValue;
+    }
+    if (percentile >= 100.0)
+    {
+        return histogram->maxValue;
+    }
+    targetCount = (uint64_t)((percentile / 100.0) * (double)histogram->totalCount + 0.5);
+    targetCount = M_Max(targetCount, UINT64_C(1));
+    for (uint32_t index = 0; index < histogram->countsLength; ++index)
+    {
+        runningCount += histogram->counts[index];
+        if (runningCount >= targetCount)
+        {
+            uint64_t lowestValue = 0;
+            uint64_t rangeSize = 0;
+            get_Index_Range(histogram, index, &lowestValue, &rangeSize);
+            return M_Min(lowestValue + rangeSize - 1, histogram->maxValue);
+        }
+    }
+    return histogram->maxValue;
+}
+
+double get_Histogram_Mean(const latencyHistogram *histogram)
+{
+    double total = 0.0;
+    if (!histogram || !histogram->counts || histogram->totalCount == 0)
+    {
+        return 0.0;
+    }
+    for (uint32_t index = 0; index < histogram->countsLength; ++index)
+    {
+        if (histogram->counts[index] > 0)
+        {
+            uint64_t lowestValue = 0;
+            uint64_t rangeSize = 0;
+            get_Index_Range(histogram, index, &lowestValue, &rangeSize);
+            total += (double)(lowestValue + (rangeSize >> 1)) * (double)histogram->counts[index];
+        }
+    }
+    return total / (double)histogram->totalCount;
+}
+
+int output_Latency_Histogram(ptrOutputWriter writer, const char *name, const latencyHistogram *histogram, bool includeBuckets)
+{
+    static const struct
+    {
+        const char *name;
+        double percentile;
+    } reportedPercentiles[] = {
+        { "p50", 50.0 },
+        { "p90", 90.0 },
+        { "p99", 99.0 },
+        { "p99_9", 99.9 },
+        { "p99_99", 99.99 },
+        { "p99_999", 99.999 },
+    };
+    if (!writer || !histogram || !histogram->counts)
+    {
+        return BAD_PARAMETER;
+    }
+    //the writer keeps the first error and ignores everything after it, so it is only checked at the end
+    begin_Output_Object(writer, name);
+    output_Unsigned_Field(writer, "count", histogram->totalCount);
+    output_Unsigned_Field(writer, "min", histogram->totalCount > 0 ? histogram->minValue : 0);
+    output_Unsigned_Field(writer, "max", histogram->maxValue);
+    output_Double_Field(writer, "mean", get_Histogram_Mean(histogram));
+    for (size_t iter = 0; iter < sizeof(reportedPercentiles) / sizeof(reportedPercentiles[0]); ++iter)
+    {
+        output_Unsigned_Field(writer, reportedPercentiles[iter].name, get_Histogram_Percentile(histogram, reportedPercentiles[iter].percentile));
+    }
+    if (includeBuckets)
+    {
+        begin_Output_Array(writer, "buckets");
+        for (uint32_t index = 0; index < histogram->countsLength && writer->lastError == SUCCESS; ++index)
+        {
+            if (histogram->counts[index] > 0)
+            {
+                uint64_t lowestValue = 0;
+                uint64_t rangeSize = 0;
+                get_Index_Range(histogram, index, &lowestValue, &rangeSize);
+                begin_Output_Object(writer, NULL);
+                output_Unsigned_Field(writer, "value", lowestValue + rangeSize - 1);
+                output_Unsigned_Field(writer, "count", histogram->counts[index]);
+                end_Output_Object(writer);
+            }
+        }
+        end_Output_Array(writer);
+    }
+    end_Output_Object(writer);
+    return writer->lastError;
+}
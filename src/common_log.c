@@ -0,0 +1,816 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_log.c
+// \brief Implements an asynchronous logger that moves console and file output off of the threads issuing commands
+//
+//Each thread that logs owns a single producer/single consumer ring of records. The owning thread is the only writer of head
+//and the writer thread (or flush_Log, while holding the consumer lock) is the only writer of tail, so no locks are needed to queue a record.
+#include "common_log.h"
+#include "common_platform.h"
+#include <ctype.h>
+#include <stddef.h>
+
+#define LOG_WRITE_BUFFER_SIZE (64 * 1024) //formatted records are collected here and written with one fwrite
+#define LOG_LINE_SIZE 4096 //largest formatted record. Longer records are truncated.
+#define LOG_CONVERSION_SIZE 64 //largest rebuilt conversion specification
+#define LOG_FULL_QUEUE_YIELD_ATTEMPTS 64 //times a thread yields while waiting on the other side of a queue before it starts sleeping
+#define LOG_MAX_RECORDS_PER_PASS 4096 //the writer lets go of the queues after this many records so flush_Log is not held off
+
+typedef enum _eLogArgumentType
+{
+    LOG_ARGUMENT_INVALID,//unsupported or malformed conversion. Nothing from here on is written.
+    LOG_ARGUMENT_PERCENT,//%%, no argument
+    LOG_ARGUMENT_SIGNED,
+    LOG_ARGUMENT_UNSIGNED,
+    LOG_ARGUMENT_CHARACTER,
+    LOG_ARGUMENT_DOUBLE,
+    LOG_ARGUMENT_POINTER,
+    LOG_ARGUMENT_STRING,
+}eLogArgumentType;
+
+typedef enum _eLogLength
+{
+    LOG_LENGTH_DEFAULT,
+    LOG_LENGTH_CHAR,//hh
+    LOG_LENGTH_SHORT,//h
+    LOG_LENGTH_LONG,//l
+    LOG_LENGTH_LONG_LONG,//ll, q, I64
+    LOG_LENGTH_INTMAX,//j
+    LOG_LENGTH_SIZE,//z, I
+    LOG_LENGTH_PTRDIFF,//t
+    LOG_LENGTH_LONG_DOUBLE,//L
+}eLogLength;
+
+//One printf conversion specification, split up so that it can be rebuilt with the captured values
+typedef struct _logConversion
+{
+    eLogArgumentType type;
+    eLogLength length;
+    char conversion;
+    const char *flags;
+    size_t flagsLength;
+    const char *width;
+    size_t widthLength;
+    bool widthStar;
+    bool hasPrecision;
+    const char *precision;
+    size_t precisionLength;
+    bool precisionStar;
+}logConversion;
+
+typedef union _logArgument
+{
+    int64_t signedValue;
+    uint64_t unsignedValue;
+    double doubleValue;
+    const void *pointerValue;
+    uint32_t stringOffset;//offset into the record's strings
+}logArgument;
+
+typedef struct _logRecord
+{
+    uint64_t timestamp;//used to write records from different threads in order
+    const char *format;
+    uint32_t argumentCount;
+    uint32_t stringUsed;
+    logArgument arguments[LOG_RECORD_MAX_ARGUMENTS];
+    char strings[LOG_RECORD_STRING_SIZE];
+}logRecord;
+
+typedef struct _logQueue
+{
+    struct _logQueue *next;//queues are only added to the list, never removed, until stop_Logging
+    volatile uint32_t owned;//1 while a thread is using this queue
+    volatile uint32_t dropped;
+    uint32_t mask;//number of records - 1
+    logRecord *records;
+    volatile uint32_t head;//next record the owning thread fills in. Only changed by the owning thread.
+    uint8_t padding[64];//keeps head and tail on different cache lines so the producer and consumer do not fight over them
+    volatile uint32_t tail;//next record to write. Only changed while holding the consumer lock.
+}logQueue;
+
+static struct _logState
+{
+    volatile uint32_t running;
+    volatile uint32_t generation;//changes every start so that threads notice their old queue is gone
+    volatile uint32_t consumerLock;
+    logQueue * volatile queues;
+    FILE *outputFile;
+    uint32_t queueRecords;
+    bool dropWhenFull;
+    uint64_t droppedRecords;//from queues that have been freed
+    seathread_t writerThread;
+    size_t writeUsed;
+    char writeBuffer[LOG_WRITE_BUFFER_SIZE];
+    char line[LOG_LINE_SIZE];
+}logState;
+
+static OPENSEA_THREAD_LOCAL logQueue *threadLogQueue = NULL;
+static OPENSEA_THREAD_LOCAL uint32_t threadLogGeneration = 0;
+
+//format points to the character after the '%'. Returns a pointer to the character after the conversion.
+static const char* parse_Log_Conversion(const char *format, logConversion *conversion)
+{
+    memset(conversion, 0, sizeof(logConversion));
+    conversion->flags = format;
+    while (*format == '-' || *format == '+' || *format == ' ' || *format == '#' || *format == '0' || *format == '\'')
+    {
+        ++format;
+    }
+    conversion->flagsLength = (size_t)(format - conversion->flags);
+    if (*format == '*')
+    {
+        conversion->widthStar = true;
+        ++format;
+    }
+    else
+    {
+        conversion->width = format;
+        while (isdigit((unsigned char)*format))
+        {
+            ++format;
+        }
+        conversion->widthLength = (size_t)(format - conversion->width);
+    }
+    if (*format == '.')
+    {
+        conversion->hasPrecision = true;
+        ++format;
+        if (*format == '*')
+        {
+            conversion->precisionStar = true;
+            ++format;
+        }
+        else
+        {
+            conversion->precision = format;
+            while (isdigit((unsigned char)*format))
+            {
+                ++format;
+            }
+            conversion->precisionLength = (size_t)(format - conversion->precision);
+        }
+    }
+    switch (*format)
+    {
+    case 'h':
+        conversion->length = format[1] == 'h' ? LOG_LENGTH_CHAR : LOG_LENGTH_SHORT;
+        format += format[1] == 'h' ? 2 : 1;
+        break;
+    case 'l':
+        conversion->length = format[1] == 'l' ? LOG_LENGTH_LONG_LONG : LOG_LENGTH_LONG;
+        format += format[1] == 'l' ? 2 : 1;
+        break;
+    case 'q':
+        conversion->length = LOG_LENGTH_LONG_LONG;
+        ++format;
+        break;
+    case 'j':
+        conversion->length = LOG_LENGTH_INTMAX;
+        ++format;
+        break;
+    case 'z':
+        conversion->length = LOG_LENGTH_SIZE;
+        ++format;
+        break;
+    case 't':
+        conversion->length = LOG_LENGTH_PTRDIFF;
+        ++format;
+        break;
+    case 'L':
+        conversion->length = LOG_LENGTH_LONG_DOUBLE;
+        ++format;
+        break;
+    case 'I'://Microsoft's I, I32, and I64
+        if (format[1] == '6' && format[2] == '4')
+        {
+            conversion->length = LOG_LENGTH_LONG_LONG;
+            format += 3;
+        }
+        else if (format[1] == '3' && format[2] == '2')
+        {
+            conversion->length = LOG_LENGTH_DEFAULT;
+            format += 3;
+        }
+        else
+        {
+            conversion->length = LOG_LENGTH_SIZE;
+            ++format;
+        }
+        break;
+    default:
+        break;
+    }
+    conversion->conversion = *format;
+    switch (*format)
+    {
+    case 'd':
+    case 'i':
+        conversion->type = LOG_ARGUMENT_SIGNED;
+        break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        conversion->type = LOG_ARGUMENT_UNSIGNED;
+        break;
+    case 'c':
+        conversion->type = conversion->length == LOG_LENGTH_LONG ? LOG_ARGUMENT_INVALID : LOG_ARGUMENT_CHARACTER;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        conversion->type = LOG_ARGUMENT_DOUBLE;
+        break;
+    case 'p':
+        conversion->type = LOG_ARGUMENT_POINTER;
+        break;
+    case 's':
+        conversion->type = conversion->length == LOG_LENGTH_LONG ? LOG_ARGUMENT_INVALID : LOG_ARGUMENT_STRING;
+        break;
+    case '%':
+        conversion->type = LOG_ARGUMENT_PERCENT;
+        break;
+    case '\0':
+        return format;//do not step past the end of the string
+    default://includes %n, which is never supported
+        conversion->type = LOG_ARGUMENT_INVALID;
+        break;
+    }
+    return format + 1;
+}
+
+static int64_t capture_Signed_Argument(eLogLength length, va_list *args)
+{
+    switch (length)
+    {
+    case LOG_LENGTH_CHAR:
+        return (signed char)va_arg(*args, int);
+    case LOG_LENGTH_SHORT:
+        return (short)va_arg(*args, int);
+    case LOG_LENGTH_LONG:
+        return va_arg(*args, long);
+    case LOG_LENGTH_LONG_LONG:
+        return va_arg(*args, long long);
+    case LOG_LENGTH_INTMAX:
+        return va_arg(*args, intmax_t);
+    case LOG_LENGTH_SIZE:
+        return (int64_t)(ptrdiff_t)va_arg(*args, size_t);
+    case LOG_LENGTH_PTRDIFF:
+        return va_arg(*args, ptrdiff_t);
+    default:
+        return va_arg(*args, int);
+    }
+}
+
+static uint64_t capture_Unsigned_Argument(eLogLength length, va_list *args)
+{
+    switch (length)
+    {
+    case LOG_LENGTH_CHAR:
+        return (unsigned char)va_arg(*args, unsigned int);
+    case LOG_LENGTH_SHORT:
+        return (unsigned short)va_arg(*args, unsigned int);
+    case LOG_LENGTH_LONG:
+        return va_arg(*args, unsigned long);
+    case LOG_LENGTH_LONG_LONG:
+        return va_arg(*args, unsigned long long);
+    case LOG_LENGTH_INTMAX:
+        return va_arg(*args, uintmax_t);
+    case LOG_LENGTH_SIZE:
+        return va_arg(*args, size_t);
+    case LOG_LENGTH_PTRDIFF:
+        return (uint64_t)(size_t)va_arg(*args, ptrdiff_t);
+    default:
+        return va_arg(*args, unsigned int);
+    }
+}
+
+//Copies a %s argument into the record. Like printf, a precision limits how much of the string is read.
+static uint32_t capture_String_Argument(logRecord *record, const char *string, bool hasPrecision, int64_t precision)
+{
+    uint32_t offset = record->stringUsed;
+    size_t maxLength = LOG_RECORD_STRING_SIZE - 1 - offset;
+    size_t length = 0;
+    if (!string)
+    {
+        string = "(null)";
+    }
+    if (hasPrecision && precision >= 0 && (uint64_t)precision < maxLength)
+    {
+        maxLength = (size_t)precision;
+    }
+    while (length < maxLength && string[length] != '\0')
+    {
+        ++length;
+    }
+    memcpy(&record->strings[offset], string, length);
+    record->strings[offset + length] = '\0';
+    record->stringUsed += (uint32_t)length + 1;
+    return offset;
+}
+
+//Walks the format string and copies every argument it uses into the record
+static void capture_Log_Record(logRecord *record, const char *format, va_list *args)
+{
+    const char *current = format;
+    record->format = format;
+    record->argumentCount = 0;
+    record->stringUsed = 0;
+    while ((current = strchr(current, '%')) != NULL)
+    {
+        logConversion conversion;
+        uint32_t needed = 0;
+        int64_t precision = -1;
+        current = parse_Log_Conversion(current + 1, &conversion);
+        if (conversion.type == LOG_ARGUMENT_INVALID)
+        {
+            break;
+        }
+        if (conversion.type == LOG_ARGUMENT_PERCENT)
+        {
+            continue;
+        }
+        needed = 1 + (conversion.widthStar ? 1 : 0) + (conversion.precisionStar ? 1 : 0);
+        if (record->argumentCount + needed > LOG_RECORD_MAX_ARGUMENTS || (conversion.type == LOG_ARGUMENT_STRING && record->stringUsed >= LOG_RECORD_STRING_SIZE))
+        {
+            //out of room. The writer stops at the same conversion since it will not have enough arguments for it.
+            break;
+        }
+        if (conversion.widthStar)
+        {
+            record->arguments[record->argumentCount++].signedValue = va_arg(*args, int);
+        }
+        if (conversion.precisionStar)
+        {
+            precision = va_arg(*args, int);
+            record->arguments[record->argumentCount++].signedValue = precision;
+        }
+        else if (conversion.hasPrecision)
+        {
+            precision = strtol(conversion.precision, NULL, 10);//an empty precision is 0, same as strtol returns
+        }
+        switch (conversion.type)
+        {
+        case LOG_ARGUMENT_SIGNED:
+            record->arguments[record->argumentCount].signedValue = capture_Signed_Argument(conversion.length, args);
+            break;
+        case LOG_ARGUMENT_UNSIGNED:
+            record->arguments[record->argumentCount].unsignedValue = capture_Unsigned_Argument(conversion.length, args);
+            break;
+        case LOG_ARGUMENT_CHARACTER:
+            record->arguments[record->argumentCount].signedValue = va_arg(*args, int);
+            break;
+        case LOG_ARGUMENT_DOUBLE:
+            if (conversion.length == LOG_LENGTH_LONG_DOUBLE)
+            {
+                record->arguments[record->argumentCount].doubleValue = (double)va_arg(*args, long double);
+            }
+            else
+            {
+                record->arguments[record->argumentCount].doubleValue = va_arg(*args, double);
+            }
+            break;
+        case LOG_ARGUMENT_POINTER:
+            record->arguments[record->argumentCount].pointerValue = va_arg(*args, const void*);
+            break;
+        case LOG_ARGUMENT_STRING:
+            record->arguments[record->argumentCount].stringOffset = capture_String_Argument(record, va_arg(*args, const char*), conversion.hasPrecision, precision);
+            break;
+        default:
+            break;
+        }
+        ++record->argumentCount;
+    }
+}
+
+static size_t append_Log_Text(char *line, size_t used, const char *text, size_t length)
+{
+    if (length > LOG_LINE_SIZE - 1 - used)
+    {
+        length = LOG_LINE_SIZE - 1 - used;
+    }
+    memcpy(&line[used], text, length);
+    return used + length;
+}
+
+//Rebuilds a conversion with the captured width and precision, and with a length modifier matching how the value was stored
+static bool build_Log_Conversion(const logConversion *conversion, const logRecord *record, uint32_t *argumentIndex, char *specification)
+{
+    int used = 0;
+    int added = 0;
+    specification[used++] = '%';
+    if (conversion->flagsLength + conversion->widthLength + conversion->precisionLength + 8 > LOG_CONVERSION_SIZE)
+    {
+        return false;
+    }
+    memcpy(&specification[used], conversion->flags, conversion->flagsLength);
+    used += (int)conversion->flagsLength;
+    if (conversion->widthStar)
+    {
+        added = snprintf(&specification[used], (size_t)(LOG_CONVERSION_SIZE - used), "%" PRId64, record->arguments[(*argumentIndex)++].signedValue);
+        if (added < 0 || added >= LOG_CONVERSION_SIZE - used)
+        {
+            return false;
+        }
+        used += added;
+    }
+    else
+    {
+        memcpy(&specification[used], conversion->width, conversion->widthLength);
+        used += (int)conversion->widthLength;
+    }
+    if (conversion->precisionStar)
+    {
+        int64_t precision = record->arguments[(*argumentIndex)++].signedValue;
+        if (precision >= 0)//printf treats a negative precision as if it was not given
+        {
+            added = snprintf(&specification[used], (size_t)(LOG_CONVERSION_SIZE - used), ".%" PRId64, precision);
+            if (added < 0 || added >= LOG_CONVERSION_SIZE - used)
+            {
+                return false;
+            }
+            used += added;
+        }
+    }
+    else if (conversion->hasPrecision)
+    {
+        specification[used++] = '.';
+        memcpy(&specification[used], conversion->precision, conversion->precisionLength);
+        used += (int)conversion->precisionLength;
+    }
+    if (LOG_CONVERSION_SIZE - used < 4)
+    {
+        return false;
+    }
+    if (conversion->type == LOG_ARGUMENT_SIGNED || conversion->type == LOG_ARGUMENT_UNSIGNED)
+    {
+        specification[used++] = 'l';
+        specification[used++] = 'l';
+    }
+    specification[used++] = conversion->conversion;
+    specification[used] = '\0';
+    return true;
+}
+
+static size_t format_Log_Record(const logRecord *record, char *line)
+{
+    const char *current = record->format;
+    uint32_t argumentIndex = 0;
+    size_t used = 0;
+    while (*current != '\0' && used < LOG_LINE_SIZE - 1)
+    {
+        const char *percent = strchr(current, '%');
+        logConversion conversion;
+        char specification[LOG_CONVERSION_SIZE];
+        uint32_t needed = 0;
+        int added = 0;
+        if (!percent)
+        {
+            used = append_Log_Text(line, used, current, strlen(current));
+            break;
+        }
+        used = append_Log_Text(line, used, current, (size_t)(percent - current));
+        current = parse_Log_Conversion(percent + 1, &conversion);
+        if (conversion.type == LOG_ARGUMENT_INVALID)
+        {
+            break;
+        }
+        if (conversion.type == LOG_ARGUMENT_PERCENT)
+        {
+            used = append_Log_Text(line, used, "%", 1);
+            continue;
+        }
+        needed = 1 + (conversion.widthStar ? 1 : 0) + (conversion.precisionStar ? 1 : 0);
+        if (argumentIndex + needed > record->argumentCount || !build_Log_Conversion(&conversion, record, &argumentIndex, specification))
+        {
+            break;
+        }
+        switch (conversion.type)
+        {
+        case LOG_ARGUMENT_SIGNED:
+            added = snprintf(&line[used], LOG_LINE_SIZE - used, specification, (long long)record->arguments[argumentIndex].signedValue);
+            break;
+        case LOG_ARGUMENT_UNSIGNED:
+            added = snprintf(&line[used], LOG_LINE_SIZE - used, specification, (unsigned long long)record->arguments[argumentIndex].unsignedValue);
+            break;
+        case LOG_ARGUMENT_CHARACTER:
+            added = snprintf(&line[used], LOG_LINE_SIZE - used, specification, (int)record->arguments[argumentIndex].signedValue);
+            break;
+        case LOG_ARGUMENT_DOUBLE:
+            added = snprintf(&line[used], LOG_LINE_SIZE - used, specification, record->arguments[argumentIndex].doubleValue);
+            break;
+        case LOG_ARGUMENT_POINTER:
+            added = snprintf(&line[used], LOG_LINE_SIZE - used, specification, record->arguments[argumentIndex].pointerValue);
+            break;
+        case LOG_ARGUMENT_STRING:
+            added = snprintf(&line[used], LOG_LINE_SIZE - used, specification, &record->strings[record->arguments[argumentIndex].stringOffset]);
+            break;
+        default:
+            break;
+        }
+        ++argumentIndex;
+        if (added < 0)
+        {
+            break;
+        }
+        used = M_Min(used + (size_t)added, LOG_LINE_SIZE - 1);
+    }
+    return used;
+}
+
+static void write_Log_Output(void)
+{
+    if (logState.writeUsed > 0)
+    {
+        fwrite(logState.writeBuffer, 1, logState.writeUsed, logState.outputFile);
+        logState.writeUsed = 0;
+    }
+}
+
+static void lock_Log_Consumer(void)
+{
+    while (!M_Atomic_Compare_Exchange(&logState.consumerLock, 0, 1))
+    {
+        delay_Milliseconds(1);
+    }
+}
+
+static void unlock_Log_Consumer(void)
+{
+    M_Atomic_Store(&logState.consumerLock, 0);
+}
+
+//Writes queued records, oldest first across all of the queues. Returns how many were written.
+static uint32_t drain_Log_Queues(void)
+{
+    uint32_t written = 0;
+    lock_Log_Consumer();
+    while (written < LOG_MAX_RECORDS_PER_PASS)
+    {
+        logQueue *queue = (logQueue*)M_Atomic_Load_Pointer(&logState.queues);
+        logQueue *oldest = NULL;
+        const logRecord *record = NULL;
+        size_t lineLength = 0;
+        for (; queue; queue = queue->next)
+        {
+            if (queue->tail != M_Atomic_Load(&queue->head))
+            {
+                const logRecord *next = &queue->records[queue->tail & queue->mask];
+                if (!oldest || next->timestamp < record->timestamp)
+                {
+                    oldest = queue;
+                    record = next;
+                }
+            }
+        }
+        if (!oldest)
+        {
+            break;
+        }
+        lineLength = format_Log_Record(record, logState.line);
+        M_Atomic_Store(&oldest->tail, oldest->tail + 1);//the record is copied into line, so the owning thread can reuse it now
+        if (lineLength > LOG_WRITE_BUFFER_SIZE - logState.writeUsed)
+        {
+            write_Log_Output();
+        }
+        memcpy(&logState.writeBuffer[logState.writeUsed], logState.line, lineLength);
+        logState.writeUsed += lineLength;
+        ++written;
+    }
+    if (written > 0)
+    {
+        write_Log_Output();
+        fflush(logState.outputFile);
+    }
+    unlock_Log_Consumer();
+    return written;
+}
+
+static void log_Writer_Thread(void *threadData)
+{
+    uint32_t idlePasses = 0;
+    M_USE_UNUSED(threadData);
+    while (M_Atomic_Load(&logState.running))
+    {
+        if (drain_Log_Queues() > 0)
+        {
+            idlePasses = 0;
+        }
+        else if (idlePasses < LOG_FULL_QUEUE_YIELD_ATTEMPTS)
+        {
+            //more records usually follow during a burst, so keep checking for a little while before sleeping
+            ++idlePasses;
+            os_Yield_Thread();
+        }
+        else
+        {
+            delay_Milliseconds(1);
+        }
+    }
+}
+
+//Gets this thread's queue, reusing a released queue or adding a new one the first time a thread logs
+static logQueue* get_Thread_Log_Queue(void)
+{
+    logQueue *queue = NULL;
+    logQueue *listHead = NULL;
+    if (threadLogQueue && threadLogGeneration == M_Atomic_Load(&logState.generation))
+    {
+        return threadLogQueue;
+    }
+    for (queue = (logQueue*)M_Atomic_Load_Pointer(&logState.queues); queue; queue = queue->next)
+    {
+        if (M_Atomic_Compare_Exchange(&queue->owned, 0, 1))
+        {
+            break;
+        }
+    }
+    if (!queue)
+    {
+        queue = (logQueue*)calloc(1, sizeof(logQueue));
+        if (!queue)
+        {
+            return NULL;
+        }
+        queue->records = (logRecord*)malloc(sizeof(logRecord) * logState.queueRecords);
+        if (!queue->records)
+        {
+            safe_Free(queue);
+            return NULL;
+        }
+        queue->mask = logState.queueRecords - 1;
+        queue->owned = 1;
+        do
+        {
+            listHead = (logQueue*)M_Atomic_Load_Pointer(&logState.queues);
+            queue->next = listHead;
+        } while (!M_Atomic_Compare_Exchange_Pointer(&logState.queues, listHead, queue));
+    }
+    threadLogQueue = queue;
+    threadLogGeneration = M_Atomic_Load(&logState.generation);
+    return queue;
+}
+
+void log_VPrintf(const char *format, va_list args)
+{
+    logQueue *queue = NULL;
+    logRecord *record = NULL;
+    seatimer_t timestamp;
+    uint32_t head = 0;
+    uint32_t fullQueueWaits = 0;
+    va_list argsCopy;
+    if (!format)
+    {
+        return;
+    }
+    if (!M_Atomic_Load(&logState.running) || NULL == (queue = get_Thread_Log_Queue()))
+    {
+        //not started (or out of memory), so write it now like printf would
+        vprintf(format, args);
+        return;
+    }
+    head = queue->head;
+    while (head - M_Atomic_Load(&queue->tail) > queue->mask)
+    {
+        if (logState.dropWhenFull)
+        {
+            M_Atomic_Increment(&queue->dropped);
+            return;
+        }
+        //the writer usually frees a record quickly, so yield to it a few times before sleeping
+        if (fullQueueWaits < LOG_FULL_QUEUE_YIELD_ATTEMPTS)
+        {
+            ++fullQueueWaits;
+            os_Yield_Thread();
+        }
+        else
+        {
+            delay_Milliseconds(1);
+        }
+    }
+    record = &queue->records[head & queue->mask];
+    memset(&timestamp, 0, sizeof(seatimer_t));
+    start_Timer(&timestamp);
+    record->timestamp = timestamp.timerStart;
+    //va_list cannot be passed by pointer portably when it is an array type, so capture from a copy
+    va_copy(argsCopy, args);
+    capture_Log_Record(record, format, &argsCopy);
+    va_end(argsCopy);
+    M_Atomic_Store(&queue->head, head + 1);
+}
+
+void log_Printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    log_VPrintf(format, args);
+    va_end(args);
+}
+
+int start_Logging(ptrLogConfig config)
+{
+    uint32_t queueRecords = LOG_DEFAULT_QUEUE_RECORDS;
+    if (M_Atomic_Load(&logState.running))
+    {
+        return FAILURE;
+    }
+    if (config && config->queueRecords > 0)
+    {
+        //round up to a power of 2 so the ring index is a mask
+        queueRecords = 1;
+        while (queueRecords < config->queueRecords && queueRecords < UINT32_C(0x80000000))
+        {
+            queueRecords <<= 1;
+        }
+    }
+    logState.outputFile = (config && config->outputFile) ? config->outputFile : stdout;
+    logState.queueRecords = queueRecords;
+    logState.dropWhenFull = config ? config->dropWhenFull : false;
+    logState.droppedRecords = 0;
+    logState.writeUsed = 0;
+    M_Atomic_Store(&logState.generation, logState.generation + 1);
+    M_Atomic_Store(&logState.running, 1);
+    if (SUCCESS != os_Create_Thread(&logState.writerThread, log_Writer_Thread, NULL))
+    {
+        M_Atomic_Store(&logState.running, 0);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int stop_Logging(void)
+{
+    logQueue *queue = NULL;
+    if (!M_Atomic_Compare_Exchange(&logState.running, 1, 0))
+    {
+        return FAILURE;
+    }
+    os_Join_Thread(&logState.writerThread);
+    while (drain_Log_Queues() > 0)
+    {
+        //keep going until everything is written
+    }
+    queue = (logQueue*)M_Atomic_Load_Pointer(&logState.queues);
+    while (queue)
+    {
+        logQueue *next = queue->next;
+        logState.droppedRecords += queue->dropped;
+        safe_Free(queue->records);
+        safe_Free(queue);
+        queue = next;
+    }
+    logState.queues = NULL;
+    return SUCCESS;
+}
+
+void flush_Log(void)
+{
+    if (M_Atomic_Load(&logState.running))
+    {
+        //a short pass means the queues were emptied. Anything queued after that is newer than this call.
+        while (drain_Log_Queues() == LOG_MAX_RECORDS_PER_PASS)
+        {
+            continue;
+        }
+        fflush(logState.outputFile);
+    }
+    else
+    {
+        fflush(stdout);
+    }
+}
+
+void release_Log_Thread_Queue(void)
+{
+    if (threadLogQueue && threadLogGeneration == M_Atomic_Load(&logState.generation))
+    {
+        M_Atomic_Store(&threadLogQueue->owned, 0);
+    }
+    threadLogQueue = NULL;
+}
+
+uint64_t get_Log_Dropped_Count(void)
+{
+    uint64_t dropped = logState.droppedRecords;
+    logQueue *queue = (logQueue*)M_Atomic_Load_Pointer(&logState.queues);
+    for (; queue; queue = queue->next)
+    {
+        dropped += M_Atomic_Load(&queue->dropped);
+    }
+    return dropped;
+}
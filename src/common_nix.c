@@ -12,6 +12,9 @@
 // \file common_nix.c
 // \brief Implements functions that are common to (u)nix like platforms code.
 //
+#if defined (__linux__) && !defined (_GNU_SOURCE)
+#define _GNU_SOURCE //needed for vmsplice and splice. Must be defined before any system header is included
+#endif
 #include "common.h"
 #include "common_nix.h"
 #include <sys/types.h>
@@ -29,8 +32,20 @@
 #include <sys/param.h> //hopefully this is available on all 'nix systems
 #include <sys/utsname.h>
 #include <unistd.h>
+#include <sched.h> //sched_yield
 #include <ctype.h>
 #include <dirent.h>//for scan dir in linux to get os name. We can move ifdef this if it doesn't work for other OS's
+#include <sys/uio.h> //writev
+#if defined (__linux__)
+#include <fcntl.h> //vmsplice and splice
+#include <sys/mman.h> //mmap for os_Map_File
+#endif
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h> //__rdtsc
+#define NIX_TIMER_COUNTER
+#elif defined (__aarch64__)
+#define NIX_TIMER_COUNTER
+#endif
 
 //freeBSD doesn't have the 64 versions of these functions...so I'm defining things this way to make it work. - TJE
 #if defined(__FreeBSD__)
@@ -70,120 +85,46 @@ int get_Full_Path(const char * pathAndFile, char fullPath[OPENSEA_PATH_MAX])
 void set_Console_Colors(bool foregroundBackground, eConsoleColors consoleColor)
 {
     //linux/BSD use the ANSI escape sequences to change colors http://tldp.org/HOWTO/Bash-Prompt-HOWTO/x329.html
-    if (foregroundBackground)//change foreground color
+    printf("%s", get_Console_Color_Escape(foregroundBackground, consoleColor));
+}
+
+bool os_Is_Console_Output(FILE *outputFile)
+{
+    if (!outputFile)
     {
-        switch (consoleColor)
-        {
-        case DARK_BLUE:
-            printf("\033[0;34m");
-            break;
-        case BLUE:
-            printf("\033[1;34m");
-            break;
-        case DARK_GREEN:
-            printf("\033[0;32m");
-            break;
-        case GREEN:
-            printf("\033[1;32m");
-            break;
-        case DARK_RED:
-            printf("\033[0;31m");
-            break;
-        case RED:
-            printf("\033[1;31m");
-            break;
-        case BLACK:
-            printf("\033[0;30m");
-            break;
-        case BROWN:
-            printf("\033[0;33m");
-            break;
-        case YELLOW:
-            printf("\033[1;33m");
-            break;
-        case TEAL:
-            printf("\033[0;36m");
-            break;
-        case CYAN:
-            printf("\033[1;36m");
-            break;
-        case PURPLE:
-            printf("\033[0;35m");
-            break;
-        case MAGENTA:
-            printf("\033[1;35m");
-            break;
-        case WHITE:
-            printf("\033[1;37m");
-            break;
-        case DARK_GRAY:
-            printf("\033[1;30m");
-            break;
-        case GRAY:
-            printf("\033[0;37m");
-            break;
-        case DEFAULT://fall through to default (which is white)
-        default:
-            printf("\033[0m");
-        }
+        return false;
+    }
+    return (1 == isatty(fileno(outputFile)));
+}
+
+int os_Write_Styled_Text(FILE *outputFile, const char *text, size_t length)
+{
+    int descriptor = -1;
+    if (!outputFile || (!text && length > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    if (0 != fflush(outputFile))
+    {
+        return FAILURE;
     }
-    else//change background color
+    descriptor = fileno(outputFile);
+    //the escape sequences are already in the text, so this is normally one write for the whole buffer
+    while (length > 0)
     {
-        switch (consoleColor)
+        ssize_t written = write(descriptor, text, length);
+        if (written < 0)
         {
-        case DARK_BLUE:
-            printf("\033[7;34m");
-            break;
-        case BLUE:
-            printf("\033[7;1;34m");
-            break;
-        case DARK_GREEN:
-            printf("\033[7;32m");
-            break;
-        case GREEN:
-            printf("\033[7;1;32m");
-            break;
-        case DARK_RED:
-            printf("\033[7;31m");
-            break;
-        case RED:
-            printf("\033[7;1;31m");
-            break;
-        case BLACK:
-            printf("\033[7;30m");
-            break;
-        case BROWN:
-            printf("\033[7;33m");
-            break;
-        case YELLOW:
-            printf("\033[7;1;33m");
-            break;
-        case TEAL:
-            printf("\033[7;36m");
-            break;
-        case CYAN:
-            printf("\033[7;1;36m");
-            break;
-        case PURPLE:
-            printf("\033[7;35m");
-            break;
-        case MAGENTA:
-            printf("\033[7;1;35m");
-            break;
-        case WHITE:
-            printf("\033[7;1;37m");
-            break;
-        case DARK_GRAY:
-            printf("\033[7;1;30m");
-            break;
-        case GRAY:
-            printf("\033[7;37m");
-            break;
-        case DEFAULT://fall through to default (which is white)
-        default:
-            printf("\033[0m");
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return FAILURE;
         }
+        text += written;
+        length -= (size_t)written;
     }
+    return SUCCESS;
 }
 
 eArchitecture get_Compiled_Architecture(void)
@@ -831,43 +772,217 @@ int64_t os_Get_File_Size(FILE *filePtr)
     }
 }
 
-void start_Timer(seatimer_t *timer)
+int os_Map_File(FILE *filePtr, seaFileMapping *mapping)
+{
+    int64_t fileSize = 0;
+    void *mapped = MAP_FAILED;
+    if (!filePtr || !mapping)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(mapping, 0, sizeof(seaFileMapping));
+    fileSize = os_Get_File_Size(filePtr);
+    if (fileSize < 0)
+    {
+        return FAILURE;
+    }
+    if ((uint64_t)fileSize > SIZE_MAX)
+    {
+        return NOT_SUPPORTED;
+    }
+    if (fileSize == 0)
+    {
+        //mmap does not accept a length of 0
+        return SUCCESS;
+    }
+    mapped = mmap(NULL, (size_t)fileSize, PROT_READ, MAP_SHARED, fileno(filePtr), 0);
+    if (mapped == MAP_FAILED)
+    {
+        return FAILURE;
+    }
+#if defined (MADV_SEQUENTIAL)
+    //only a hint for read ahead, so a failure does not matter
+    madvise(mapped, (size_t)fileSize, MADV_SEQUENTIAL);
+#endif
+    mapping->data = (const uint8_t*)mapped;
+    mapping->length = (uint64_t)fileSize;
+    return SUCCESS;
+}
+
+int os_Unmap_File(seaFileMapping *mapping)
 {
-    struct timespec startTimespec;
-    int ret = 0;
-    memset(&startTimespec, 0, sizeof(struct timespec));
-    ret = clock_gettime(CLOCK_MONOTONIC, &startTimespec);
-    if (0 == ret)//hopefully this always works...-TJE
+    if (!mapping)
     {
-//        printf("Start Time:  %lu\n", startTimespec.tv_nsec);
-        timer->timerStart = (uint64_t) (startTimespec.tv_sec * (uint64_t) 1000000000) + startTimespec.tv_nsec;
+        return BAD_PARAMETER;
     }
-//    else
-//    {
-//       printf("Bad start_timer Ret:  %d\n",ret);
-//    }
+    if (mapping->data && 0 != munmap((void*)mapping->data, (size_t)mapping->length))
+    {
+        return FAILURE;
+    }
+    memset(mapping, 0, sizeof(seaFileMapping));
+    return SUCCESS;
 }
 
-void stop_Timer(seatimer_t *timer)
+static bool read_Monotonic_Clock(uint64_t *nanoseconds)
+{
+    struct timespec now;
+    if (0 != clock_gettime(CLOCK_MONOTONIC, &now))
+    {
+        return false;
+    }
+    *nanoseconds = (uint64_t)now.tv_sec * UINT64_C(1000000000) + (uint64_t)now.tv_nsec;
+    return true;
+}
+
+#if defined (NIX_TIMER_COUNTER)
+//Timers read the CPU's own counter (the TSC, or the aarch64 virtual counter) when it counts at a constant rate, which costs a few nanoseconds
+//instead of a clock_gettime call. The counts are turned into nanoseconds with a scale found once against CLOCK_MONOTONIC.
+//Otherwise timer values are CLOCK_MONOTONIC nanoseconds. Either way the choice is made once, so every timer value in a process has the same units.
+#define NIX_TIMER_CALIBRATION_NS UINT64_C(5000000) //how long the counter is compared to CLOCK_MONOTONIC
+#define NIX_TIMER_CALIBRATION_TRIES 8
+#define NIX_TIMER_SCALE_SHIFT 32 //counterScale is nanoseconds per count in 32.32 fixed point
+#define NIX_TIMER_MIN_SCALE ((UINT64_C(1) << NIX_TIMER_SCALE_SHIFT) / 100) //100GHz
+#define NIX_TIMER_MAX_SCALE ((UINT64_C(1) << NIX_TIMER_SCALE_SHIFT) * 1000) //1MHz
+
+static pthread_once_t timerCalibrationOnce = PTHREAD_ONCE_INIT;
+static bool timerUsesCounter = false;
+static uint64_t counterScale = 0;
+
+static uint64_t read_Timer_Counter(void)
+{
+#if defined (__aarch64__)
+    uint64_t count = 0;
+    //isb keeps the read from happening before the instructions in front of it
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(count) : : "memory");
+    return count;
+#else
+    //rdtsc can also start early, which matters when timing very short operations
+    __asm__ __volatile__("lfence" : : : "memory");
+    return __rdtsc();
+#endif
+}
+
+static bool is_Timer_Counter_Stable(void)
+{
+#if defined (__aarch64__)
+    //the generic timer always counts at a fixed rate and is the same on every CPU
+    return true;
+#else
+    if (!(get_CPU_Features() & CPU_FEATURE_INVARIANT_TSC))
+    {
+        return false;
+    }
+#if defined (__linux__)
+    {
+        //The kernel stops using the TSC when it finds the CPUs' TSCs are not in sync, or a hypervisor says it is not reliable, so follow its choice.
+        FILE *clockSource = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+        if (clockSource)
+        {
+            char name[16] = { 0 };
+            bool usingTSC = fgets(name, sizeof(name), clockSource) && 0 == strncmp(name, "tsc", 3);
+            fclose(clockSource);
+            return usingTSC;
+        }
+    }
+#endif
+    return true;
+#endif
+}
+
+//Reads the clock between two counter reads and uses the counter value half way between them. The tightest of a few tries is kept,
+//since an interrupt in the middle of one would throw the calibration off.
+static bool read_Clock_And_Counter(uint64_t *nanoseconds, uint64_t *count)
 {
-    struct timespec stopTimespec;
-    int ret = 0;
-    memset(&stopTimespec, 0, sizeof(struct timespec));
-    ret = clock_gettime(CLOCK_MONOTONIC, &stopTimespec);
-    if (0 == ret)//hopefully this always works...-TJE
+    uint64_t tightest = UINT64_MAX;
+    for (uint8_t attempt = 0; attempt < NIX_TIMER_CALIBRATION_TRIES; ++attempt)
     {
-//        printf("Stop Time:  %lu\n", stopTimespec.tv_nsec);
-        timer->timerStop = (uint64_t) (stopTimespec.tv_sec * (uint64_t) 1000000000) + stopTimespec.tv_nsec;
+        uint64_t clockValue = 0;
+        uint64_t before = read_Timer_Counter();
+        bool clockRead = read_Monotonic_Clock(&clockValue);
+        uint64_t after = read_Timer_Counter();
+        if (!clockRead)
+        {
+            return false;
+        }
+        if (after - before < tightest)
+        {
+            tightest = after - before;
+            *nanoseconds = clockValue;
+            *count = before + (after - before) / 2;
+        }
     }
-//    else
-//    {
-//       printf("Bad stop_timer Ret:  %d\n",ret);
-//    }
+    return true;
+}
+
+static void calibrate_Timer(void)
+{
+    uint64_t startNanoseconds = 0;
+    uint64_t stopNanoseconds = 0;
+    uint64_t startCount = 0;
+    uint64_t stopCount = 0;
+    uint64_t scale = 0;
+    if (!is_Timer_Counter_Stable() || !read_Clock_And_Counter(&startNanoseconds, &startCount))
+    {
+        return;
+    }
+    do
+    {
+        if (!read_Clock_And_Counter(&stopNanoseconds, &stopCount))
+        {
+            return;
+        }
+    } while (stopNanoseconds - startNanoseconds < NIX_TIMER_CALIBRATION_NS);
+    if (stopCount <= startCount)
+    {
+        return;
+    }
+    scale = ((stopNanoseconds - startNanoseconds) << NIX_TIMER_SCALE_SHIFT) / (stopCount - startCount);
+    //a rate far outside any real counter means something (such as a migration between hosts) went wrong, so keep using the clock
+    if (scale >= NIX_TIMER_MIN_SCALE && scale <= NIX_TIMER_MAX_SCALE)
+    {
+        counterScale = scale;
+        timerUsesCounter = true;
+    }
+}
+#endif
+
+static void read_Timer_Value(uint64_t *timerValue)
+{
+#if defined (NIX_TIMER_COUNTER)
+    pthread_once(&timerCalibrationOnce, calibrate_Timer);
+    if (timerUsesCounter)
+    {
+        *timerValue = read_Timer_Counter();
+        return;
+    }
+#endif
+    //the value is left alone if the clock cannot be read
+    read_Monotonic_Clock(timerValue);
+}
+
+void start_Timer(seatimer_t *timer)
+{
+    read_Timer_Value(&timer->timerStart);
+}
+
+void stop_Timer(seatimer_t *timer)
+{
+    read_Timer_Value(&timer->timerStop);
 }
 
 uint64_t get_Nano_Seconds(seatimer_t timer)
 {
-    return timer.timerStop - timer.timerStart;
+    uint64_t elapsed = timer.timerStop - timer.timerStart;
+#if defined (NIX_TIMER_COUNTER)
+    pthread_once(&timerCalibrationOnce, calibrate_Timer);
+    if (timerUsesCounter)
+    {
+        uint64_t high = 0;
+        uint64_t low = multiply_64_To_128(elapsed, counterScale, &high);
+        return (high << (64 - NIX_TIMER_SCALE_SHIFT)) | (low >> NIX_TIMER_SCALE_SHIFT);
+    }
+#endif
+    return elapsed;
 }
 
 double get_Micro_Seconds(seatimer_t timer)
@@ -885,3 +1000,250 @@ double get_Seconds(seatimer_t timer)
 {
     return (get_Milli_Seconds(timer) / 1000.00);
 }
+
+static void *nix_Thread_Start(void *threadParam)
+{
+    seathread_t *thread = (seathread_t*)threadParam;
+    thread->threadFunction(thread->threadData);
+    return NULL;
+}
+
+int os_Create_Thread(seathread_t *thread, seathreadfunc_t threadFunction, void *threadData)
+{
+    if (!thread || !threadFunction)
+    {
+        return BAD_PARAMETER;
+    }
+    thread->threadFunction = threadFunction;
+    thread->threadData = threadData;
+    if (0 != pthread_create(&thread->threadHandle, NULL, nix_Thread_Start, thread))
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int os_Join_Thread(seathread_t *thread)
+{
+    if (!thread || 0 != pthread_join(thread->threadHandle, NULL))
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+uint32_t os_Get_Processor_Count(void)
+{
+#if defined (_SC_NPROCESSORS_ONLN)
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processors > 0)
+    {
+        return (uint32_t)processors;
+    }
+#endif
+    return 1;
+}
+
+void os_Yield_Thread(void)
+{
+    sched_yield();
+}
+
+#define NIX_RAW_OUTPUT_MAX_VECTORS 64 //iovecs passed per writev/vmsplice call. Well under IOV_MAX everywhere
+#define NIX_RAW_OUTPUT_COPY_SIZE (64 * 1024) //chunk size when moving file data with splice or copying it
+
+static FILE* get_Raw_Output_File(OutputInfo *outputInfo)
+{
+    return outputInfo->outputFilePtr ? outputInfo->outputFilePtr : stdout;
+}
+
+#if defined (__linux__)
+static bool is_Pipe_Descriptor(int descriptor)
+{
+    struct stat st;
+    memset(&st, 0, sizeof(struct stat));
+    return (0 == fstat(descriptor, &st) && S_ISFIFO(st.st_mode));
+}
+#endif
+
+int os_Write_Raw_Output(OutputInfo *outputInfo, const tDataPtr *dataList, uint32_t dataCount, bool zeroCopy)
+{
+    struct iovec vectors[NIX_RAW_OUTPUT_MAX_VECTORS];
+    uint32_t dataIndex = 0;
+    size_t dataOffset = 0;//bytes of dataList[dataIndex] that are already written
+    int descriptor = -1;
+#if defined (__linux__)
+    bool useVmsplice = false;
+#endif
+    if (!outputInfo || (!dataList && dataCount > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    if (outputInfo->outputFormat != SEAC_OUTPUT_RAW)
+    {
+        return NOT_SUPPORTED;
+    }
+    for (dataIndex = 0; dataIndex < dataCount; ++dataIndex)
+    {
+        if (!dataList[dataIndex].pData && dataList[dataIndex].DataLen > 0)
+        {
+            return BAD_PARAMETER;
+        }
+    }
+    if (0 != fflush(get_Raw_Output_File(outputInfo)))
+    {
+        return FAILURE;
+    }
+    descriptor = fileno(get_Raw_Output_File(outputInfo));
+#if defined (__linux__)
+    useVmsplice = zeroCopy && is_Pipe_Descriptor(descriptor);
+#endif
+    dataIndex = 0;
+    while (dataIndex < dataCount)
+    {
+        int vectorCount = 0;
+        uint32_t vectorIndex = dataIndex;
+        size_t vectorOffset = dataOffset;
+        ssize_t written = 0;
+        for (; vectorIndex < dataCount && vectorCount < NIX_RAW_OUTPUT_MAX_VECTORS; ++vectorIndex)
+        {
+            if (dataList[vectorIndex].DataLen > vectorOffset)
+            {
+                vectors[vectorCount].iov_base = (uint8_t*)dataList[vectorIndex].pData + vectorOffset;
+                vectors[vectorCount].iov_len = dataList[vectorIndex].DataLen - vectorOffset;
+                ++vectorCount;
+            }
+            vectorOffset = 0;
+        }
+        if (vectorCount == 0)
+        {
+            break;//only empty buffers left
+        }
+#if defined (__linux__)
+        if (useVmsplice)
+        {
+            written = vmsplice(descriptor, vectors, (unsigned long)vectorCount, 0);
+            if (written < 0 && (errno == EINVAL || errno == ENOSYS))
+            {
+                //not supported for this pipe, so fall back to copying with writev
+                useVmsplice = false;
+                continue;
+            }
+        }
+        else
+#endif
+        {
+            written = writev(descriptor, vectors, vectorCount);
+        }
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return FAILURE;
+        }
+        //move past everything that was written. Partial writes stop in the middle of a buffer.
+        while (dataIndex < dataCount && (size_t)written >= dataList[dataIndex].DataLen - dataOffset)
+        {
+            written -= (ssize_t)(dataList[dataIndex].DataLen - dataOffset);
+            dataOffset = 0;
+            ++dataIndex;
+        }
+        if (dataIndex < dataCount)
+        {
+            dataOffset += (size_t)written;
+        }
+    }
+    return SUCCESS;
+}
+
+//Copies the data through a buffer using the file pointer so that anything already buffered in inputFile is used
+static int copy_Raw_File_Output(int outputDescriptor, FILE *inputFile, uint64_t length)
+{
+    int ret = SUCCESS;
+    uint8_t *copyBuffer = (uint8_t*)malloc(NIX_RAW_OUTPUT_COPY_SIZE);
+    if (!copyBuffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (length > 0 && ret == SUCCESS)
+    {
+        size_t readLength = fread(copyBuffer, 1, (size_t)M_Min(length, NIX_RAW_OUTPUT_COPY_SIZE), inputFile);
+        size_t writeOffset = 0;
+        if (readLength == 0)
+        {
+            ret = FAILURE;//end of file or read error before length bytes
+            break;
+        }
+        while (writeOffset < readLength)
+        {
+            ssize_t written = write(outputDescriptor, &copyBuffer[writeOffset], readLength - writeOffset);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ret = FAILURE;
+                break;
+            }
+            writeOffset += (size_t)written;
+        }
+        length -= readLength;
+    }
+    safe_Free(copyBuffer);
+    return ret;
+}
+
+int os_Write_Raw_File_Output(OutputInfo *outputInfo, FILE *inputFile, uint64_t length)
+{
+    int outputDescriptor = -1;
+    if (!outputInfo || !inputFile)
+    {
+        return BAD_PARAMETER;
+    }
+    if (outputInfo->outputFormat != SEAC_OUTPUT_RAW)
+    {
+        return NOT_SUPPORTED;
+    }
+    if (0 != fflush(get_Raw_Output_File(outputInfo)))
+    {
+        return FAILURE;
+    }
+    outputDescriptor = fileno(get_Raw_Output_File(outputInfo));
+#if defined (__linux__)
+    if (is_Pipe_Descriptor(outputDescriptor))
+    {
+        //ftello gives the position the caller sees, even if stdio has read ahead. splice is given that offset so it does not depend on the descriptor's own position.
+        off_t startPosition = ftello(inputFile);
+        if (startPosition >= 0)
+        {
+            loff_t inputOffset = (loff_t)startPosition;
+            int inputDescriptor = fileno(inputFile);
+            uint64_t remaining = length;
+            while (remaining > 0)
+            {
+                ssize_t moved = splice(inputDescriptor, &inputOffset, outputDescriptor, NULL, (size_t)M_Min(remaining, NIX_RAW_OUTPUT_COPY_SIZE), SPLICE_F_MOVE | (remaining > NIX_RAW_OUTPUT_COPY_SIZE ? SPLICE_F_MORE : 0));
+                if (moved < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (moved <= 0)
+                {
+                    break;
+                }
+                remaining -= (uint64_t)moved;
+            }
+            if (remaining == length)
+            {
+                //nothing was moved. This input cannot be spliced (or is at end of file), so copy it instead.
+                return copy_Raw_File_Output(outputDescriptor, inputFile, length);
+            }
+            fseeko(inputFile, (off_t)inputOffset, SEEK_SET);
+            return remaining == 0 ? SUCCESS : FAILURE;
+        }
+    }
+#endif
+    return copy_Raw_File_Output(outputDescriptor, inputFile, length);
+}
@@ -0,0 +1,787 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_output.c
+// \brief Implements a streaming writer for the structured eOutputFormat types (text, JSON, CSV, XML)
+//
+#include "common_output.h"
+#include "common_encode.h"
+#include <ctype.h>
+#include <stddef.h>
+#include <math.h>
+
+#define OUTPUT_WRITER_INDENT_WIDTH 4
+#define OUTPUT_WRITER_NUMBER_LENGTH 32 //big enough for any 64bit integer or a %.15g double
+#define OUTPUT_WRITER_ENCODE_CHUNK 768 //binary bytes encoded at a time. A multiple of 3 so base64 padding only happens at the end.
+
+typedef void (*outputAppendFunc)(ptrOutputWriter writer, const char *data, size_t length);
+
+//Binary data for output_Binary_Field. Hex and base64 characters never need escaping or quoting in any format.
+typedef struct _outputBinaryValue
+{
+    const uint8_t *data;
+    size_t length;
+    bool base64;
+}outputBinaryValue;
+
+static const char outputWriterSpaces[] = "                                "; //32 spaces
+static const char outputWriterHexDigits[] = "0123456789ABCDEF";
+
+static void set_Output_Error(ptrOutputWriter writer, int error)
+{
+    if (writer->lastError == SUCCESS)
+    {
+        writer->lastError = error;
+    }
+}
+
+static void flush_Output_Buffer(ptrOutputWriter writer)
+{
+    if (writer->bufferUsed > 0)
+    {
+        if (fwrite(writer->buffer, 1, writer->bufferUsed, writer->outputFile) != writer->bufferUsed)
+        {
+            set_Output_Error(writer, FAILURE);
+        }
+        writer->bufferUsed = 0;
+    }
+}
+
+//All output goes through here. While the first CSV row is open, it's values are held back so that the header can be written before them.
+static void append_Output(ptrOutputWriter writer, const char *data, size_t length)
+{
+    if (writer->lastError != SUCCESS || length == 0)
+    {
+        return;
+    }
+    if (writer->outputFormat == SEAC_OUTPUT_CSV && writer->csvRowDepth > 0 && !writer->csvHeaderWritten)
+    {
+        if (length > OUTPUT_WRITER_CSV_HEADER_SIZE - writer->csvFirstRowUsed)
+        {
+            set_Output_Error(writer, MEMORY_FAILURE);
+            return;
+        }
+        memcpy(&writer->csvFirstRow[writer->csvFirstRowUsed], data, length);
+        writer->csvFirstRowUsed += length;
+        return;
+    }
+    if (length > OUTPUT_WRITER_BUFFER_SIZE - writer->bufferUsed)
+    {
+        flush_Output_Buffer(writer);
+        if (length >= OUTPUT_WRITER_BUFFER_SIZE)
+        {
+            //too big to be worth buffering, so write it straight out
+            if (fwrite(data, 1, length, writer->outputFile) != length)
+            {
+                set_Output_Error(writer, FAILURE);
+            }
+            return;
+        }
+    }
+    memcpy(&writer->buffer[writer->bufferUsed], data, length);
+    writer->bufferUsed += length;
+}
+
+static void append_CSV_Header(ptrOutputWriter writer, const char *data, size_t length)
+{
+    if (writer->lastError != SUCCESS || length == 0)
+    {
+        return;
+    }
+    if (length > OUTPUT_WRITER_CSV_HEADER_SIZE - writer->csvHeaderUsed)
+    {
+        set_Output_Error(writer, MEMORY_FAILURE);
+        return;
+    }
+    memcpy(&writer->csvHeader[writer->csvHeaderUsed], data, length);
+    writer->csvHeaderUsed += length;
+}
+
+static void append_Output_String(ptrOutputWriter writer, const char *string)
+{
+    append_Output(writer, string, strlen(string));
+}
+
+static void append_Indent(ptrOutputWriter writer, uint8_t level)
+{
+    size_t spaces = (size_t)level * OUTPUT_WRITER_INDENT_WIDTH;
+    while (spaces > 0)
+    {
+        size_t length = M_Min(spaces, sizeof(outputWriterSpaces) - 1);
+        append_Output(writer, outputWriterSpaces, length);
+        spaces -= length;
+    }
+}
+
+static size_t unsigned_To_Decimal(char *string, uint64_t value)
+{
+    char reversed[OUTPUT_WRITER_NUMBER_LENGTH];
+    size_t length = 0, iter = 0;
+    do
+    {
+        reversed[length++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value > 0);
+    for (iter = 0; iter < length; ++iter)
+    {
+        string[iter] = reversed[length - iter - 1];
+    }
+    string[length] = '\0';
+    return length;
+}
+
+//Returns the replacement text for a character that cannot be written as-is in the given format, or NULL if it can be written as-is.
+static const char* get_Escape_Sequence(eOutputFormat format, unsigned char character, char *scratch)
+{
+    switch (format)
+    {
+    case SEAC_OUTPUT_JSON:
+        switch (character)
+        {
+        case '"':
+            return "\\\"";
+        case '\\':
+            return "\\\\";
+        case '\n':
+            return "\\n";
+        case '\r':
+            return "\\r";
+        case '\t':
+            return "\\t";
+        default:
+            if (character < 0x20)
+            {
+                scratch[0] = '\\';
+                scratch[1] = 'u';
+                scratch[2] = '0';
+                scratch[3] = '0';
+                scratch[4] = outputWriterHexDigits[character >> 4];
+                scratch[5] = outputWriterHexDigits[character & 0x0F];
+                scratch[6] = '\0';
+                return scratch;
+            }
+            break;
+        }
+        break;
+    case SEAC_OUTPUT_XML:
+        switch (character)
+        {
+        case '&':
+            return "&amp;";
+        case '<':
+            return "&lt;";
+        case '>':
+            return "&gt;";
+        case '"':
+            return "&quot;";
+        case '\'':
+            return "&apos;";
+        case '\n':
+        case '\r':
+        case '\t':
+            break;
+        default:
+            if (character < 0x20)
+            {
+                //not allowed in XML 1.0, even escaped
+                return "?";
+            }
+            break;
+        }
+        break;
+    case SEAC_OUTPUT_CSV:
+        if (character == '"')
+        {
+            return "\"\"";
+        }
+        break;
+    default:
+        break;
+    }
+    return NULL;
+}
+
+//Writes the string in runs, only stopping for the characters that need to be escaped
+static void append_Escaped(ptrOutputWriter writer, outputAppendFunc append, const char *string)
+{
+    const char *runStart = string;
+    const char *current = string;
+    char scratch[8];
+    for (; *current != '\0'; ++current)
+    {
+        const char *escape = get_Escape_Sequence(writer->outputFormat, (unsigned char)*current, scratch);
+        if (escape)
+        {
+            append(writer, runStart, (size_t)(current - runStart));
+            append(writer, escape, strlen(escape));
+            runStart = current + 1;
+        }
+    }
+    append(writer, runStart, (size_t)(current - runStart));
+}
+
+static void append_Binary(ptrOutputWriter writer, const outputBinaryValue *binary)
+{
+    char encoded[HEX_ENCODED_LENGTH(OUTPUT_WRITER_ENCODE_CHUNK)];
+    size_t offset = 0;
+    while (offset < binary->length && writer->lastError == SUCCESS)
+    {
+        size_t chunkLength = M_Min(binary->length - offset, OUTPUT_WRITER_ENCODE_CHUNK);
+        if (binary->base64)
+        {
+            base64_Encode(&binary->data[offset], chunkLength, encoded, sizeof(encoded));
+            append_Output(writer, encoded, BASE64_ENCODED_LENGTH(chunkLength));
+        }
+        else
+        {
+            hex_Encode(&binary->data[offset], chunkLength, encoded, sizeof(encoded), true);
+            append_Output(writer, encoded, HEX_ENCODED_LENGTH(chunkLength));
+        }
+        offset += chunkLength;
+    }
+}
+
+static bool csv_Needs_Quotes(const char *string)
+{
+    size_t length = strlen(string);
+    if (length > 0 && (string[0] == ' ' || string[length - 1] == ' '))
+    {
+        return true;
+    }
+    return strpbrk(string, ",\"\r\n") != NULL;
+}
+
+static void append_CSV_Value(ptrOutputWriter writer, outputAppendFunc append, const char *string)
+{
+    if (csv_Needs_Quotes(string))
+    {
+        append(writer, "\"", 1);
+        append_Escaped(writer, append, string);
+        append(writer, "\"", 1);
+    }
+    else
+    {
+        append(writer, string, strlen(string));
+    }
+}
+
+//XML element names can only use letters, digits, '-', '_', and '.', and cannot start with a digit, '-', or '.'. Anything else is changed to '_'
+static void append_XML_Name(ptrOutputWriter writer, const char *name)
+{
+    const char *current = name;
+    if (!isalpha((unsigned char)*current) && *current != '_')
+    {
+        append_Output(writer, "_", 1);
+    }
+    for (; *current != '\0'; ++current)
+    {
+        if (isalnum((unsigned char)*current) || *current == '-' || *current == '_' || *current == '.')
+        {
+            append_Output(writer, current, 1);
+        }
+        else
+        {
+            append_Output(writer, "_", 1);
+        }
+    }
+}
+
+//Picks the name an item is written with. Items in arrays, and unnamed items in objects, are named by their index. XML uses "item" instead since element names cannot be numbers.
+static const char* get_Item_Name(ptrOutputWriter writer, const char *name, char *indexName)
+{
+    outputWriterLevel *parent = &writer->levels[writer->depth];
+    if (writer->outputFormat == SEAC_OUTPUT_XML)
+    {
+        if (writer->depth == 0 && !name)
+        {
+            return writer->rootName;
+        }
+        if (parent->isArray || !name)
+        {
+            return "item";
+        }
+        return name;
+    }
+    if (parent->isArray || !name)
+    {
+        unsigned_To_Decimal(indexName, parent->childCount);
+        return indexName;
+    }
+    return name;
+}
+
+//CSV columns are named by every open level below the row followed by the field name, separated with '.'
+static void append_CSV_Column_Name(ptrOutputWriter writer, const char *itemName)
+{
+    uint8_t level = 0;
+    for (level = writer->csvRowDepth + 1; level <= writer->depth; ++level)
+    {
+        append_CSV_Value(writer, append_CSV_Header, &writer->nameStack[writer->levels[level].nameOffset]);
+        append_CSV_Header(writer, ".", 1);
+    }
+    append_CSV_Value(writer, append_CSV_Header, itemName);
+}
+
+//JSON and XML only have one outermost item, and it has to be an object or array to hold any names
+static bool is_Valid_Top_Level_Item(ptrOutputWriter writer, const char *name, bool isField)
+{
+    if (writer->depth > 0 || (writer->outputFormat != SEAC_OUTPUT_JSON && writer->outputFormat != SEAC_OUTPUT_XML))
+    {
+        return true;
+    }
+    return writer->levels[0].childCount == 0 && !(isField && name);
+}
+
+//Writes everything that comes before an item's value: separators, indentation, and the item's name
+static void begin_Output_Item(ptrOutputWriter writer, const char *itemName)
+{
+    outputWriterLevel *parent = &writer->levels[writer->depth];
+    switch (writer->outputFormat)
+    {
+    case SEAC_OUTPUT_JSON:
+        if (parent->childCount > 0)
+        {
+            append_Output(writer, ",", 1);
+        }
+        if (writer->prettyPrint && (writer->depth > 0 || parent->childCount > 0))
+        {
+            append_Output(writer, "\n", 1);
+            append_Indent(writer, writer->depth);
+        }
+        if (writer->depth > 0 && !parent->isArray)
+        {
+            append_Output(writer, "\"", 1);
+            append_Escaped(writer, append_Output, itemName);
+            append_Output_String(writer, writer->prettyPrint ? "\": " : "\":");
+        }
+        break;
+    case SEAC_OUTPUT_XML:
+        if (writer->prettyPrint)
+        {
+            append_Output(writer, "\n", 1);
+            append_Indent(writer, writer->depth);
+        }
+        break;
+    case SEAC_OUTPUT_TEXT:
+        if (writer->depth > 1)
+        {
+            append_Indent(writer, writer->depth - 1);
+        }
+        break;
+    default:
+        break;
+    }
+    ++parent->childCount;
+}
+
+static int begin_Output_Level(ptrOutputWriter writer, const char *name, bool isArray)
+{
+    char indexName[OUTPUT_WRITER_NUMBER_LENGTH];
+    const char *itemName = NULL;
+    size_t nameLength = 0;
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    if (writer->lastError != SUCCESS)
+    {
+        return writer->lastError;
+    }
+    if (writer->depth >= OUTPUT_WRITER_MAX_DEPTH || !is_Valid_Top_Level_Item(writer, name, false))
+    {
+        set_Output_Error(writer, BAD_PARAMETER);
+        return writer->lastError;
+    }
+    itemName = get_Item_Name(writer, name, indexName);
+    nameLength = strlen(itemName) + 1;
+    if (nameLength > (size_t)(OUTPUT_WRITER_NAME_STACK_SIZE - writer->nameStackUsed))
+    {
+        set_Output_Error(writer, MEMORY_FAILURE);
+        return writer->lastError;
+    }
+    begin_Output_Item(writer, itemName);
+    switch (writer->outputFormat)
+    {
+    case SEAC_OUTPUT_JSON:
+        append_Output(writer, isArray ? "[" : "{", 1);
+        break;
+    case SEAC_OUTPUT_XML:
+        append_Output(writer, "<", 1);
+        append_XML_Name(writer, itemName);
+        append_Output(writer, ">", 1);
+        break;
+    case SEAC_OUTPUT_TEXT:
+        //the outermost unnamed object or array is just a container and is not shown
+        if (writer->depth > 0 || name)
+        {
+            append_Output_String(writer, itemName);
+            append_Output(writer, ":\n", 2);
+        }
+        break;
+    default:
+        break;
+    }
+    ++writer->depth;
+    writer->levels[writer->depth].isArray = isArray;
+    writer->levels[writer->depth].childCount = 0;
+    writer->levels[writer->depth].nameOffset = writer->nameStackUsed;
+    memcpy(&writer->nameStack[writer->nameStackUsed], itemName, nameLength);
+    writer->nameStackUsed += (uint16_t)nameLength;
+    if (writer->outputFormat == SEAC_OUTPUT_CSV && !isArray && writer->csvRowDepth == 0 && writer->levels[writer->depth - 1].isArray)
+    {
+        writer->csvRowDepth = writer->depth;
+        writer->csvColumn = 0;
+    }
+    return writer->lastError;
+}
+
+static int end_Output_Level(ptrOutputWriter writer, bool isArray)
+{
+    outputWriterLevel *level = NULL;
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    if (writer->lastError != SUCCESS)
+    {
+        return writer->lastError;
+    }
+    if (writer->depth == 0 || writer->levels[writer->depth].isArray != isArray)
+    {
+        set_Output_Error(writer, BAD_PARAMETER);
+        return writer->lastError;
+    }
+    level = &writer->levels[writer->depth];
+    switch (writer->outputFormat)
+    {
+    case SEAC_OUTPUT_JSON:
+        if (writer->prettyPrint && level->childCount > 0)
+        {
+            append_Output(writer, "\n", 1);
+            append_Indent(writer, writer->depth - 1);
+        }
+        append_Output(writer, isArray ? "]" : "}", 1);
+        break;
+    case SEAC_OUTPUT_XML:
+        if (writer->prettyPrint && level->childCount > 0)
+        {
+            append_Output(writer, "\n", 1);
+            append_Indent(writer, writer->depth - 1);
+        }
+        append_Output(writer, "</", 2);
+        append_XML_Name(writer, &writer->nameStack[level->nameOffset]);
+        append_Output(writer, ">", 1);
+        break;
+    case SEAC_OUTPUT_CSV:
+        if (writer->depth == writer->csvRowDepth)
+        {
+            writer->csvRowDepth = 0;
+            if (!writer->csvHeaderWritten)
+            {
+                writer->csvHeaderWritten = true;
+                append_Output(writer, writer->csvHeader, writer->csvHeaderUsed);
+                append_Output(writer, "\n", 1);
+                append_Output(writer, writer->csvFirstRow, writer->csvFirstRowUsed);
+            }
+            append_Output(writer, "\n", 1);
+        }
+        break;
+    default:
+        break;
+    }
+    writer->nameStackUsed = level->nameOffset;
+    --writer->depth;
+    return writer->lastError;
+}
+
+//Writes a single field. value has already been converted to text. isString selects JSON quoting and escaping.
+//When binary is not NULL, it is encoded in place of value and written like a string.
+static int output_Field(ptrOutputWriter writer, const char *name, const char *value, bool isString, const outputBinaryValue *binary)
+{
+    char indexName[OUTPUT_WRITER_NUMBER_LENGTH];
+    const char *itemName = NULL;
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    if (writer->lastError != SUCCESS)
+    {
+        return writer->lastError;
+    }
+    if (!is_Valid_Top_Level_Item(writer, name, true))
+    {
+        set_Output_Error(writer, BAD_PARAMETER);
+        return writer->lastError;
+    }
+    itemName = get_Item_Name(writer, name, indexName);
+    switch (writer->outputFormat)
+    {
+    case SEAC_OUTPUT_JSON:
+        begin_Output_Item(writer, itemName);
+        if (binary)
+        {
+            append_Output(writer, "\"", 1);
+            append_Binary(writer, binary);
+            append_Output(writer, "\"", 1);
+        }
+        else if (!value)
+        {
+            append_Output(writer, "null", 4);
+        }
+        else if (isString)
+        {
+            append_Output(writer, "\"", 1);
+            append_Escaped(writer, append_Output, value);
+            append_Output(writer, "\"", 1);
+        }
+        else
+        {
+            append_Output_String(writer, value);
+        }
+        break;
+    case SEAC_OUTPUT_XML:
+        begin_Output_Item(writer, itemName);
+        append_Output(writer, "<", 1);
+        append_XML_Name(writer, itemName);
+        if (binary ? binary->length == 0 : (!value || *value == '\0'))
+        {
+            append_Output(writer, "/>", 2);
+        }
+        else
+        {
+            append_Output(writer, ">", 1);
+            if (binary)
+            {
+                append_Binary(writer, binary);
+            }
+            else
+            {
+                append_Escaped(writer, append_Output, value);
+            }
+            append_Output(writer, "</", 2);
+            append_XML_Name(writer, itemName);
+            append_Output(writer, ">", 1);
+        }
+        break;
+    case SEAC_OUTPUT_CSV:
+        if (writer->csvRowDepth == 0)
+        {
+            append_CSV_Value(writer, append_Output, itemName);
+            append_Output(writer, ",", 1);
+            if (binary)
+            {
+                append_Binary(writer, binary);
+            }
+            else
+            {
+                append_CSV_Value(writer, append_Output, value ? value : "");
+            }
+            append_Output(writer, "\n", 1);
+        }
+        else
+        {
+            if (writer->csvColumn > 0)
+            {
+                append_Output(writer, ",", 1);
+                if (!writer->csvHeaderWritten)
+                {
+                    append_CSV_Header(writer, ",", 1);
+                }
+            }
+            if (!writer->csvHeaderWritten)
+            {
+                append_CSV_Column_Name(writer, itemName);
+            }
+            if (binary)
+            {
+                append_Binary(writer, binary);
+            }
+            else
+            {
+                append_CSV_Value(writer, append_Output, value ? value : "");
+            }
+            ++writer->csvColumn;
+        }
+        ++writer->levels[writer->depth].childCount;
+        break;
+    case SEAC_OUTPUT_TEXT:
+    default:
+        begin_Output_Item(writer, itemName);
+        append_Output_String(writer, itemName);
+        append_Output(writer, ": ", 2);
+        if (binary)
+        {
+            append_Binary(writer, binary);
+        }
+        else if (value)
+        {
+            append_Output_String(writer, value);
+        }
+        append_Output(writer, "\n", 1);
+        break;
+    }
+    return writer->lastError;
+}
+
+int init_Output_Writer(ptrOutputWriter writer, OutputInfo *outputInfo)
+{
+    if (!writer || !outputInfo)
+    {
+        return BAD_PARAMETER;
+    }
+    switch (outputInfo->outputFormat)
+    {
+    case SEAC_OUTPUT_TEXT:
+    case SEAC_OUTPUT_JSON:
+    case SEAC_OUTPUT_CSV:
+    case SEAC_OUTPUT_XML:
+        break;
+    default:
+        return NOT_SUPPORTED;
+    }
+    //only the state needs to be cleared. The buffers are always written before they are read.
+    memset(writer, 0, offsetof(outputWriter, csvHeader));
+    writer->outputFormat = outputInfo->outputFormat;
+    writer->outputFile = outputInfo->outputFilePtr ? outputInfo->outputFilePtr : stdout;
+    writer->rootName = (outputInfo->utilityName && *outputInfo->utilityName) ? *outputInfo->utilityName : "output";
+    writer->prettyPrint = true;
+    writer->lastError = SUCCESS;
+    if (writer->outputFormat == SEAC_OUTPUT_XML)
+    {
+        append_Output_String(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+    }
+    return SUCCESS;
+}
+
+int begin_Output_Object(ptrOutputWriter writer, const char *name)
+{
+    return begin_Output_Level(writer, name, false);
+}
+
+int begin_Output_Array(ptrOutputWriter writer, const char *name)
+{
+    return begin_Output_Level(writer, name, true);
+}
+
+int end_Output_Object(ptrOutputWriter writer)
+{
+    return end_Output_Level(writer, false);
+}
+
+int end_Output_Array(ptrOutputWriter writer)
+{
+    return end_Output_Level(writer, true);
+}
+
+int output_String_Field(ptrOutputWriter writer, const char *name, const char *value)
+{
+    return output_Field(writer, name, value, true, NULL);
+}
+
+int output_Unsigned_Field(ptrOutputWriter writer, const char *name, uint64_t value)
+{
+    char number[OUTPUT_WRITER_NUMBER_LENGTH];
+    unsigned_To_Decimal(number, value);
+    return output_Field(writer, name, number, false, NULL);
+}
+
+int output_Signed_Field(ptrOutputWriter writer, const char *name, int64_t value)
+{
+    char number[OUTPUT_WRITER_NUMBER_LENGTH];
+    if (value < 0)
+    {
+        number[0] = '-';
+        //negate as unsigned so that INT64_MIN does not overflow
+        unsigned_To_Decimal(&number[1], (uint64_t)0 - (uint64_t)value);
+    }
+    else
+    {
+        unsigned_To_Decimal(number, (uint64_t)value);
+    }
+    return output_Field(writer, name, number, false, NULL);
+}
+
+int output_Hex_Field(ptrOutputWriter writer, const char *name, uint64_t value)
+{
+    char number[OUTPUT_WRITER_NUMBER_LENGTH];
+    char *digit = &number[OUTPUT_WRITER_NUMBER_LENGTH - 1];
+    *digit = '\0';
+    do
+    {
+        *--digit = outputWriterHexDigits[value & 0x0F];
+        value >>= 4;
+    } while (value > 0);
+    *--digit = 'x';
+    *--digit = '0';
+    return output_Field(writer, name, digit, true, NULL);
+}
+
+int output_Double_Field(ptrOutputWriter writer, const char *name, double value)
+{
+    char number[OUTPUT_WRITER_NUMBER_LENGTH];
+    if (isnan(value) || isinf(value))
+    {
+        //JSON has no way to represent these
+        return output_Field(writer, name, writer && writer->outputFormat == SEAC_OUTPUT_JSON ? NULL : (isnan(value) ? "nan" : (value < 0 ? "-inf" : "inf")), false, NULL);
+    }
+    snprintf(number, OUTPUT_WRITER_NUMBER_LENGTH, "%.15g", value);
+    return output_Field(writer, name, number, false, NULL);
+}
+
+int output_Bool_Field(ptrOutputWriter writer, const char *name, bool value)
+{
+    return output_Field(writer, name, value ? "true" : "false", false, NULL);
+}
+
+int output_Binary_Field(ptrOutputWriter writer, const char *name, const uint8_t *data, size_t length, bool base64)
+{
+    outputBinaryValue binary;
+    if (!data && length > 0)
+    {
+        return BAD_PARAMETER;
+    }
+    binary.data = data;
+    binary.length = length;
+    binary.base64 = base64;
+    return output_Field(writer, name, NULL, true, &binary);
+}
+
+int flush_Output_Writer(ptrOutputWriter writer)
+{
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    flush_Output_Buffer(writer);
+    if (fflush(writer->outputFile) != 0)
+    {
+        set_Output_Error(writer, FAILURE);
+    }
+    return writer->lastError;
+}
+
+int finish_Output_Writer(ptrOutputWriter writer)
+{
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    while (writer->depth > 0 && writer->lastError == SUCCESS)
+    {
+        end_Output_Level(writer, writer->levels[writer->depth].isArray);
+    }
+    //end JSON and XML with a newline like the other formats
+    if ((writer->outputFormat == SEAC_OUTPUT_JSON && writer->levels[0].childCount > 0) || writer->outputFormat == SEAC_OUTPUT_XML)
+    {
+        append_Output(writer, "\n", 1);
+    }
+    return flush_Output_Writer(writer);
+}
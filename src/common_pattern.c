@@ -0,0 +1,1371 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_pattern.c
+// \brief Implements fast data pattern generation for large buffers, such as the payloads for write tests
+//
+#include "common_pattern.h"
+#include "common_checksum.h"
+
+#if defined (OPENSEA_CPU_X86)
+#include <immintrin.h>
+#elif defined (__aarch64__) || defined (_M_ARM64)
+#define OPENSEA_PATTERN_NEON
+#include <arm_neon.h>
+#endif
+
+#define RANDOM_FILL_SEED_VALUES (RANDOM_FILL_LANES * 4) //splitmix64 values used to seed one segment
+
+//Segment N uses splitmix64 values N * RANDOM_FILL_SEED_VALUES through N * RANDOM_FILL_SEED_VALUES + RANDOM_FILL_SEED_VALUES - 1 of the sequence started at the seed
+static void seed_Random_Fill_Segment(ptrRandomFillState fillState, uint64_t seed, uint64_t segment)
+{
+    uint64_t splitState = seed + segment * RANDOM_FILL_SEED_VALUES * SPLITMIX64_INCREMENT;
+    for (uint8_t lane = 0; lane < RANDOM_FILL_LANES; ++lane)
+    {
+        //splitmix64 never repeats a value within this range, so no lane can be all zeros
+        fillState->lanes[0][lane] = splitmix64(&splitState);
+        fillState->lanes[1][lane] = splitmix64(&splitState);
+        fillState->lanes[2][lane] = splitmix64(&splitState);
+        fillState->lanes[3][lane] = splitmix64(&splitState);
+    }
+}
+
+void seed_Random_Fill_State(ptrRandomFillState fillState, uint64_t seed)
+{
+    if (fillState)
+    {
+        seed_Random_Fill_Segment(fillState, seed, 0);
+    }
+}
+
+//xoshiro256** on every lane, one block per step
+static void fill_Random_Blocks_Scalar(ptrRandomFillState fillState, uint8_t *ptrData, size_t blockCount)
+{
+    for (size_t block = 0; block < blockCount; ++block, ptrData += RANDOM_FILL_BLOCK_SIZE)
+    {
+        for (uint8_t lane = 0; lane < RANDOM_FILL_LANES; ++lane)
+        {
+            uint64_t state0 = fillState->lanes[0][lane];
+            uint64_t state1 = fillState->lanes[1][lane];
+            uint64_t state2 = fillState->lanes[2][lane];
+            uint64_t state3 = fillState->lanes[3][lane];
+            uint64_t const result = rotate_Left_64(state1 * 5, 7) * 9;
+            uint64_t const shifted = state1 << 17;
+            state2 ^= state0;
+            state3 ^= state1;
+            state1 ^= state2;
+            state0 ^= state3;
+            state2 ^= shifted;
+            state3 = rotate_Left_64(state3, 45);
+            fillState->lanes[0][lane] = state0;
+            fillState->lanes[1][lane] = state1;
+            fillState->lanes[2][lane] = state2;
+            fillState->lanes[3][lane] = state3;
+            memcpy(&ptrData[lane * sizeof(uint64_t)], &result, sizeof(uint64_t));
+        }
+    }
+}
+
+#if defined (OPENSEA_CPU_X86)
+//AVX2 has no 64bit multiply, but *5 and *9 are a shift and an add
+#define AVX2_ROTATE_LEFT_64(value, count) _mm256_or_si256(_mm256_slli_epi64(value, count), _mm256_srli_epi64(value, 64 - (count)))
+#define AVX2_XOSHIRO_STEP(state0, state1, state2, state3, result) \
+    do { \
+        __m256i shifted = _mm256_slli_epi64(state1, 17); \
+        result = _mm256_add_epi64(state1, _mm256_slli_epi64(state1, 2)); \
+        result = AVX2_ROTATE_LEFT_64(result, 7); \
+        result = _mm256_add_epi64(result, _mm256_slli_epi64(result, 3)); \
+        state2 = _mm256_xor_si256(state2, state0); \
+        state3 = _mm256_xor_si256(state3, state1); \
+        state1 = _mm256_xor_si256(state1, state2); \
+        state0 = _mm256_xor_si256(state0, state3); \
+        state2 = _mm256_xor_si256(state2, shifted); \
+        state3 = AVX2_ROTATE_LEFT_64(state3, 45); \
+    } while (0)
+
+//lanes 0-3 and 4-7 are kept in separate registers, which also gives the CPU two independent chains to overlap
+OPENSEA_TARGET("avx2")
+static void fill_Random_Blocks_AVX2(ptrRandomFillState fillState, uint8_t *ptrData, size_t blockCount)
+{
+    __m256i low0 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[0][0]);
+    __m256i low1 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[1][0]);
+    __m256i low2 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[2][0]);
+    __m256i low3 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[3][0]);
+    __m256i high0 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[0][4]);
+    __m256i high1 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[1][4]);
+    __m256i high2 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[2][4]);
+    __m256i high3 = _mm256_loadu_si256((const __m256i*)&fillState->lanes[3][4]);
+    for (size_t block = 0; block < blockCount; ++block, ptrData += RANDOM_FILL_BLOCK_SIZE)
+    {
+        __m256i lowResult;
+        __m256i highResult;
+        AVX2_XOSHIRO_STEP(low0, low1, low2, low3, lowResult);
+        AVX2_XOSHIRO_STEP(high0, high1, high2, high3, highResult);
+        _mm256_storeu_si256((__m256i*)ptrData, lowResult);
+        _mm256_storeu_si256((__m256i*)(ptrData + 32), highResult);
+    }
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[0][0], low0);
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[1][0], low1);
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[2][0], low2);
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[3][0], low3);
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[0][4], high0);
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[1][4], high1);
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[2][4], high2);
+    _mm256_storeu_si256((__m256i*)&fillState->lanes[3][4], high3);
+}
+#elif defined (OPENSEA_PATTERN_NEON)
+#define NEON_ROTATE_LEFT_64(value, count) vorrq_u64(vshlq_n_u64(value, count), vshrq_n_u64(value, 64 - (count)))
+
+//2 lanes per register, so the 8 lanes are 4 sets of registers
+static void fill_Random_Blocks_NEON(ptrRandomFillState fillState, uint8_t *ptrData, size_t blockCount)
+{
+    uint64x2_t state0[4];
+    uint64x2_t state1[4];
+    uint64x2_t state2[4];
+    uint64x2_t state3[4];
+    for (uint8_t set = 0; set < 4; ++set)
+    {
+        state0[set] = vld1q_u64(&fillState->lanes[0][set * 2]);
+        state1[set] = vld1q_u64(&fillState->lanes[1][set * 2]);
+        state2[set] = vld1q_u64(&fillState->lanes[2][set * 2]);
+        state3[set] = vld1q_u64(&fillState->lanes[3][set * 2]);
+    }
+    for (size_t block = 0; block < blockCount; ++block, ptrData += RANDOM_FILL_BLOCK_SIZE)
+    {
+        for (uint8_t set = 0; set < 4; ++set)
+        {
+            uint64x2_t shifted = vshlq_n_u64(state1[set], 17);
+            uint64x2_t result = vaddq_u64(state1[set], vshlq_n_u64(state1[set], 2));
+            result = NEON_ROTATE_LEFT_64(result, 7);
+            result = vaddq_u64(result, vshlq_n_u64(result, 3));
+            state2[set] = veorq_u64(state2[set], state0[set]);
+            state3[set] = veorq_u64(state3[set], state1[set]);
+            state1[set] = veorq_u64(state1[set], state2[set]);
+            state0[set] = veorq_u64(state0[set], state3[set]);
+            state2[set] = veorq_u64(state2[set], shifted);
+            state3[set] = NEON_ROTATE_LEFT_64(state3[set], 45);
+            vst1q_u8(ptrData + set * 16, vreinterpretq_u8_u64(result));
+        }
+    }
+    for (uint8_t set = 0; set < 4; ++set)
+    {
+        vst1q_u64(&fillState->lanes[0][set * 2], state0[set]);
+        vst1q_u64(&fillState->lanes[1][set * 2], state1[set]);
+        vst1q_u64(&fillState->lanes[2][set * 2], state2[set]);
+        vst1q_u64(&fillState->lanes[3][set * 2], state3[set]);
+    }
+}
+#endif
+
+static void fill_Random_Blocks(ptrRandomFillState fillState, uint8_t *ptrData, size_t blockCount)
+{
+#if defined (OPENSEA_CPU_X86)
+    if (get_CPU_Features() & CPU_FEATURE_AVX2)
+    {
+        fill_Random_Blocks_AVX2(fillState, ptrData, blockCount);
+        return;
+    }
+#elif defined (OPENSEA_PATTERN_NEON)
+    fill_Random_Blocks_NEON(fillState, ptrData, blockCount);
+    return;
+#endif
+    fill_Random_Blocks_Scalar(fillState, ptrData, blockCount);
+}
+
+int fill_Random_Pattern_From_State(ptrRandomFillState fillState, uint8_t *ptrData, size_t dataLength)
+{
+    size_t wholeBlocks = dataLength / RANDOM_FILL_BLOCK_SIZE;
+    size_t tailLength = dataLength % RANDOM_FILL_BLOCK_SIZE;
+    if (!fillState || (!ptrData && dataLength > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    fill_Random_Blocks(fillState, ptrData, wholeBlocks);
+    if (tailLength > 0)
+    {
+        uint8_t tailBlock[RANDOM_FILL_BLOCK_SIZE];
+        fill_Random_Blocks(fillState, tailBlock, 1);
+        memcpy(&ptrData[wholeBlocks * RANDOM_FILL_BLOCK_SIZE], tailBlock, tailLength);
+    }
+    return SUCCESS;
+}
+
+//fills dataLength bytes starting at the beginning of the given segment of a seeded random fill
+static void fill_Random_Segments(uint64_t seed, uint64_t firstSegment, uint8_t *ptrData, size_t dataLength)
+{
+    randomFillState fillState;
+    uint64_t segment = firstSegment;
+    for (size_t offset = 0; offset < dataLength; offset += RANDOM_FILL_SEGMENT_SIZE, ++segment)
+    {
+        seed_Random_Fill_Segment(&fillState, seed, segment);
+        fill_Random_Pattern_From_State(&fillState, &ptrData[offset], M_Min(RANDOM_FILL_SEGMENT_SIZE, dataLength - offset));
+    }
+}
+
+int fill_Seeded_Random_Pattern_In_Buffer(uint64_t seed, uint8_t *ptrData, size_t dataLength)
+{
+    if (!ptrData && dataLength > 0)
+    {
+        return BAD_PARAMETER;
+    }
+    fill_Random_Segments(seed, 0, ptrData, dataLength);
+    return SUCCESS;
+}
+
+#define PATTERN_FILL_DOUBLING_SIZE (32 * 1024) //a repeating pattern is doubled in place until it is this long, then that block is copied over the rest of the buffer
+
+#if defined (OPENSEA_CPU_X86)
+//copies with non-temporal stores, which write straight to memory instead of filling the cache. Callers must _mm_sfence before the data is used by another thread.
+static void copy_Non_Temporal(uint8_t *destination, const uint8_t *source, size_t length)
+{
+    size_t offset = M_Min((16 - ((uintptr_t)destination & 15)) & 15, length);
+    //the streaming stores need 16 byte alignment
+    memcpy(destination, source, offset);
+    for (; offset + 16 <= length; offset += 16)
+    {
+        _mm_stream_si128((__m128i*)&destination[offset], _mm_loadu_si128((const __m128i*)&source[offset]));
+    }
+    memcpy(&destination[offset], &source[offset], length - offset);
+}
+#endif
+
+int fill_Repeating_Pattern_In_Buffer(const uint8_t *pattern, size_t patternLength, uint8_t *ptrData, size_t dataLength)
+{
+    size_t blockLength = 0;
+#if defined (OPENSEA_CPU_X86)
+    bool streaming = dataLength >= PATTERN_FILL_STREAMING_LENGTH;
+#endif
+    if (!pattern || patternLength == 0 || (!ptrData && dataLength > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    //build a block of whole pattern copies at the start of the buffer by copying what is there onto the end of itself
+    blockLength = M_Min(patternLength, dataLength);
+    memcpy(ptrData, pattern, blockLength);
+    while (blockLength < PATTERN_FILL_DOUBLING_SIZE && blockLength < dataLength)
+    {
+        size_t copyLength = M_Min(blockLength, dataLength - blockLength);
+        memcpy(&ptrData[blockLength], ptrData, copyLength);
+        blockLength += copyLength;
+    }
+    //then repeat that block, which stays in the cache, over the rest of the buffer
+    for (size_t offset = blockLength; offset < dataLength; offset += blockLength)
+    {
+        size_t copyLength = M_Min(blockLength, dataLength - offset);
+#if defined (OPENSEA_CPU_X86)
+        if (streaming)
+        {
+            copy_Non_Temporal(&ptrData[offset], ptrData, copyLength);
+            continue;
+        }
+#endif
+        memcpy(&ptrData[offset], ptrData, copyLength);
+    }
+#if defined (OPENSEA_CPU_X86)
+    if (streaming)
+    {
+        _mm_sfence();
+    }
+#endif
+    return SUCCESS;
+}
+
+#define PATTERN_MAX_THREADS 64
+#define PATTERN_MIN_THREAD_LENGTH (4 * 1024 * 1024) //smaller pieces finish before a thread is worth starting
+
+typedef struct _patternThreadChunk
+{
+    void (*chunkFunction)(const struct _patternThreadChunk *chunk);
+    void *job;//shared by every chunk
+    uint32_t chunkIndex;
+    uint64_t firstUnit;
+    uint64_t unitCount;
+    bool threadStarted;
+}patternThreadChunk;
+
+static void run_Pattern_Thread_Chunk(void *chunkData)
+{
+    const patternThreadChunk *chunk = (const patternThreadChunk*)chunkData;
+    chunk->chunkFunction(chunk);
+}
+
+//Splits unitCount units of work on a dataLength byte buffer into one piece per thread, each a multiple of unitAlignment units,
+//and runs chunkFunction on every piece. The calling thread does the last piece itself. Returns the number of pieces once they are all done.
+static uint32_t run_Pattern_Threads(void (*chunkFunction)(const patternThreadChunk *chunk), void *job, uint64_t unitCount, uint64_t unitAlignment, size_t dataLength, uint32_t threadCount)
+{
+    patternThreadChunk chunks[PATTERN_MAX_THREADS];
+    seathread_t threads[PATTERN_MAX_THREADS];
+    uint64_t chunkUnits = 0;
+    uint32_t chunkCount = 0;
+    if (threadCount == 0)
+    {
+        threadCount = os_Get_Processor_Count();
+    }
+    threadCount = (uint32_t)M_Max(1, M_Min(M_Min(threadCount, PATTERN_MAX_THREADS), dataLength / PATTERN_MIN_THREAD_LENGTH));
+    chunkUnits = (unitCount + threadCount - 1) / threadCount;
+    chunkUnits = ((chunkUnits + unitAlignment - 1) / unitAlignment) * unitAlignment;
+    for (uint64_t firstUnit = 0; firstUnit < unitCount; firstUnit += chunkUnits, ++chunkCount)
+    {
+        chunks[chunkCount].chunkFunction = chunkFunction;
+        chunks[chunkCount].job = job;
+        chunks[chunkCount].chunkIndex = chunkCount;
+        chunks[chunkCount].firstUnit = firstUnit;
+        chunks[chunkCount].unitCount = M_Min(chunkUnits, unitCount - firstUnit);
+        chunks[chunkCount].threadStarted = false;
+        if (firstUnit + chunkUnits < unitCount && SUCCESS == os_Create_Thread(&threads[chunkCount], run_Pattern_Thread_Chunk, &chunks[chunkCount]))
+        {
+            chunks[chunkCount].threadStarted = true;
+        }
+        else
+        {
+            chunkFunction(&chunks[chunkCount]);
+        }
+    }
+    for (uint32_t iter = 0; iter < chunkCount; ++iter)
+    {
+        if (chunks[iter].threadStarted)
+        {
+            os_Join_Thread(&threads[iter]);
+        }
+    }
+    return chunkCount;
+}
+
+typedef enum _ePatternFillType
+{
+    PATTERN_FILL_HEX,
+    PATTERN_FILL_INCREMENTING,
+    PATTERN_FILL_RANDOM,
+}ePatternFillType;
+
+typedef struct _patternFillJob
+{
+    ePatternFillType fillType;
+    uint64_t value;//hex pattern, incrementing start value, or random seed
+    uint8_t *ptrData;//start of the whole buffer
+}patternFillJob;
+
+//chunk units are bytes, and each chunk starts on a multiple of RANDOM_FILL_SEGMENT_SIZE
+static void fill_Pattern_Chunk(const patternThreadChunk *chunk)
+{
+    const patternFillJob *job = (const patternFillJob*)chunk->job;
+    size_t chunkStart = (size_t)chunk->firstUnit;
+    size_t chunkLength = (size_t)chunk->unitCount;
+    uint8_t *chunkPtr = &job->ptrData[chunkStart];
+    if (job->fillType == PATTERN_FILL_RANDOM)
+    {
+        fill_Random_Segments(job->value, chunkStart / RANDOM_FILL_SEGMENT_SIZE, chunkPtr, chunkLength);
+    }
+    else if (job->fillType == PATTERN_FILL_HEX)
+    {
+        uint32_t hexPattern = (uint32_t)job->value;
+        fill_Repeating_Pattern_In_Buffer((const uint8_t*)&hexPattern, sizeof(uint32_t), chunkPtr, chunkLength);
+    }
+    else
+    {
+        //chunkStart is a multiple of 256, so the pattern starts with the same value as the whole buffer
+        uint8_t pattern[UINT8_MAX + 1];
+        for (uint16_t offset = 0; offset <= UINT8_MAX; ++offset)
+        {
+            pattern[offset] = (uint8_t)(job->value + offset);
+        }
+        fill_Repeating_Pattern_In_Buffer(pattern, sizeof(pattern), chunkPtr, chunkLength);
+    }
+}
+
+//Pieces start on RANDOM_FILL_SEGMENT_SIZE boundaries, so each piece makes exactly the bytes a single threaded fill would.
+static int fill_Pattern_Threaded(ePatternFillType fillType, uint64_t value, uint8_t *ptrData, size_t dataLength, uint32_t threadCount)
+{
+    patternFillJob job;
+    if (!ptrData && dataLength > 0)
+    {
+        return BAD_PARAMETER;
+    }
+    job.fillType = fillType;
+    job.value = value;
+    job.ptrData = ptrData;
+    run_Pattern_Threads(fill_Pattern_Chunk, &job, dataLength, RANDOM_FILL_SEGMENT_SIZE, dataLength, threadCount);
+    return SUCCESS;
+}
+
+int fill_Hex_Pattern_In_Large_Buffer(uint32_t hexPattern, uint8_t *ptrData, size_t dataLength, uint32_t threadCount)
+{
+    return fill_Pattern_Threaded(PATTERN_FILL_HEX, hexPattern, ptrData, dataLength, threadCount);
+}
+
+int fill_Incrementing_Pattern_In_Large_Buffer(uint8_t incrementStartValue, uint8_t *ptrData, size_t dataLength, uint32_t threadCount)
+{
+    return fill_Pattern_Threaded(PATTERN_FILL_INCREMENTING, incrementStartValue, ptrData, dataLength, threadCount);
+}
+
+int fill_Seeded_Random_Pattern_In_Large_Buffer(uint64_t seed, uint8_t *ptrData, size_t dataLength, uint32_t threadCount)
+{
+    return fill_Pattern_Threaded(PATTERN_FILL_RANDOM, seed, ptrData, dataLength, threadCount);
+}
+
+//draws a single replacement value for one that was rejected by random_Range_Array_32/64
+static uint32_t redraw_Range_Value_32(ptrRandomFillState fillState, uint32_t range, uint32_t threshold)
+{
+    uint64_t product = 0;
+    do
+    {
+        uint32_t value = 0;
+        fill_Random_Pattern_From_State(fillState, (uint8_t*)&value, sizeof(uint32_t));
+        product = (uint64_t)value * range;
+    } while ((uint32_t)product < threshold);
+    return (uint32_t)(product >> 32);
+}
+
+#if defined (OPENSEA_CPU_X86)
+//Maps 8 values at a time. _mm256_mul_epu32 only multiplies the even 32bit elements, so the odd ones are shifted down and multiplied separately.
+//Returns how many values were done. Rejected values are redrawn in order, the same as the scalar loop.
+OPENSEA_TARGET("avx2")
+static size_t map_Range_Values_32_AVX2(ptrRandomFillState fillState, uint32_t rangeMin, uint32_t range, uint32_t threshold, uint32_t *values, size_t count)
+{
+    size_t offset = 0;
+    __m256i rangeVector = _mm256_set1_epi32((int32_t)range);
+    __m256i minVector = _mm256_set1_epi32((int32_t)rangeMin);
+    __m256i signBit = _mm256_set1_epi32(INT32_MIN);
+    __m256i thresholdVector = _mm256_xor_si256(_mm256_set1_epi32((int32_t)threshold), signBit);
+    for (; offset + 8 <= count; offset += 8)
+    {
+        __m256i random = _mm256_loadu_si256((const __m256i*)&values[offset]);
+        __m256i evenProducts = _mm256_mul_epu32(random, rangeVector);
+        __m256i oddProducts = _mm256_mul_epu32(_mm256_srli_epi64(random, 32), rangeVector);
+        __m256i highHalves = _mm256_blend_epi32(_mm256_srli_epi64(evenProducts, 32), oddProducts, 0xAA);
+        __m256i lowHalves = _mm256_blend_epi32(evenProducts, _mm256_slli_epi64(oddProducts, 32), 0xAA);
+        //no unsigned compare, so flip the sign bits and compare signed
+        int rejected = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(thresholdVector, _mm256_xor_si256(lowHalves, signBit))));
+        _mm256_storeu_si256((__m256i*)&values[offset], _mm256_add_epi32(highHalves, minVector));
+        while (rejected)
+        {
+            int lane = 0;
+            while (!(rejected & (1 << lane)))
+            {
+                ++lane;
+            }
+            rejected &= ~(1 << lane);
+            values[offset + (size_t)lane] = rangeMin + redraw_Range_Value_32(fillState, range, threshold);
+        }
+    }
+    return offset;
+}
+#endif
+
+int random_Range_Array_32(ptrRandomFillState fillState, uint32_t rangeMin, uint32_t rangeMax, uint32_t *values, size_t count)
+{
+    uint32_t range = 0;
+    uint32_t threshold = 0;
+    size_t offset = 0;
+    if (!fillState || (!values && count > 0) || count > SIZE_MAX / sizeof(uint32_t))
+    {
+        return BAD_PARAMETER;
+    }
+    if (rangeMin > rangeMax)
+    {
+        uint32_t swap = rangeMin;
+        rangeMin = rangeMax;
+        rangeMax = swap;
+    }
+    //generate all the random bits at once with the SIMD fill, then scale them into the range in place
+    fill_Random_Pattern_From_State(fillState, (uint8_t*)values, count * sizeof(uint32_t));
+    range = rangeMax - rangeMin + 1;
+    if (range == 0)
+    {
+        //full 32bit range, the random values are already correct
+        return SUCCESS;
+    }
+    threshold = (0 - range) % range;
+#if defined (OPENSEA_CPU_X86)
+    if (get_CPU_Features() & CPU_FEATURE_AVX2)
+    {
+        offset = map_Range_Values_32_AVX2(fillState, rangeMin, range, threshold, values, count);
+    }
+#endif
+    for (; offset < count; ++offset)
+    {
+        uint64_t product = (uint64_t)values[offset] * range;
+        if ((uint32_t)product < threshold)
+        {
+            values[offset] = rangeMin + redraw_Range_Value_32(fillState, range, threshold);
+        }
+        else
+        {
+            values[offset] = rangeMin + (uint32_t)(product >> 32);
+        }
+    }
+    return SUCCESS;
+}
+
+int random_Range_Array_64(ptrRandomFillState fillState, uint64_t rangeMin, uint64_t rangeMax, uint64_t *values, size_t count)
+{
+    uint64_t range = 0;
+    uint64_t threshold = 0;
+    if (!fillState || (!values && count > 0) || count > SIZE_MAX / sizeof(uint64_t))
+    {
+        return BAD_PARAMETER;
+    }
+    if (rangeMin > rangeMax)
+    {
+        uint64_t swap = rangeMin;
+        rangeMin = rangeMax;
+        rangeMax = swap;
+    }
+    fill_Random_Pattern_From_State(fillState, (uint8_t*)values, count * sizeof(uint64_t));
+    range = rangeMax - rangeMin + 1;
+    if (range == 0)
+    {
+        return SUCCESS;
+    }
+    threshold = (0 - range) % range;
+    //there is no 64bit high multiply in AVX2 or NEON, so this part stays scalar. It is a single multiply instruction on 64bit CPUs.
+    for (size_t offset = 0; offset < count; ++offset)
+    {
+        uint64_t productHigh = 0;
+        uint64_t productLow = multiply_64_To_128(values[offset], range, &productHigh);
+        while (productLow < threshold)
+        {
+            uint64_t value = 0;
+            fill_Random_Pattern_From_State(fillState, (uint8_t*)&value, sizeof(uint64_t));
+            productLow = multiply_64_To_128(value, range, &productHigh);
+        }
+        values[offset] = rangeMin + productHigh;
+    }
+    return SUCCESS;
+}
+
+#define PATTERN_VERIFY_CHUNK_SIZE (16 * 1024) //expected data is regenerated this much at a time. A multiple of RANDOM_FILL_BLOCK_SIZE so random streams continue across chunks.
+
+static uint8_t count_Bits_32(uint32_t value)
+{
+    uint8_t count = 0;
+    for (; value; value &= value - 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+static uint8_t lowest_Bit_32(uint32_t value)
+{
+    uint8_t bit = 0;
+    while (!(value & (UINT32_C(1) << bit)))
+    {
+        ++bit;
+    }
+    return bit;
+}
+
+static void mark_Verify_Sector(ptrPatternVerifyResult result, uint64_t sector)
+{
+    if (sector / 8 < result->sectorBitmapSize)
+    {
+        result->sectorBitmap[sector / 8] |= (uint8_t)(1 << (sector % 8));
+    }
+}
+
+//records the bytes set in differenceMask. Bit N is the byte at offset + N.
+static void record_Verify_Differences(ptrPatternVerifyResult result, uint32_t differenceMask, uint64_t offset)
+{
+    uint64_t firstSector = 0;
+    uint64_t lastSector = 0;
+    uint8_t lowBit = lowest_Bit_32(differenceMask);
+    uint8_t highBit = 31;
+    while (!(differenceMask & (UINT32_C(1) << highBit)))
+    {
+        --highBit;
+    }
+    if (result->differentBytes == 0)
+    {
+        result->firstDifferenceOffset = offset + lowBit;
+    }
+    result->differentBytes += count_Bits_32(differenceMask);
+    firstSector = (offset + lowBit) / result->sectorSize;
+    lastSector = (offset + highBit) / result->sectorSize;
+    if (firstSector == lastSector)
+    {
+        //the usual case, since sectors are much larger than the 32 bytes one mask covers
+        if (firstSector != result->lastDifferentSector || result->differentSectors == 0)
+        {
+            ++result->differentSectors;
+            result->lastDifferentSector = firstSector;
+            mark_Verify_Sector(result, firstSector);
+        }
+        return;
+    }
+    for (uint8_t bit = lowBit; bit <= highBit; ++bit)
+    {
+        uint64_t sector = (offset + bit) / result->sectorSize;
+        if ((differenceMask & (UINT32_C(1) << bit)) && (sector != result->lastDifferentSector || result->differentSectors == 0))
+        {
+            ++result->differentSectors;
+            result->lastDifferentSector = sector;
+            mark_Verify_Sector(result, sector);
+        }
+    }
+}
+
+//returns a mask with bit N set when byte N of the two 32 byte blocks is different
+static uint32_t compare_32_Bytes(const uint8_t *expected, const uint8_t *actual)
+{
+#if defined (OPENSEA_CPU_X86)
+    //SSE2 is part of every x86_64 CPU
+    __m128i equalLow = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)expected), _mm_loadu_si128((const __m128i*)actual));
+    __m128i equalHigh = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(expected + 16)), _mm_loadu_si128((const __m128i*)(actual + 16)));
+    return ~((uint32_t)_mm_movemask_epi8(equalLow) | ((uint32_t)_mm_movemask_epi8(equalHigh) << 16));
+#else
+    uint32_t differenceMask = 0;
+    #if defined (OPENSEA_PATTERN_NEON)
+    uint8x16_t difference = vorrq_u8(veorq_u8(vld1q_u8(expected), vld1q_u8(actual)), veorq_u8(vld1q_u8(expected + 16), vld1q_u8(actual + 16)));
+    if (vmaxvq_u8(difference) == 0)
+    {
+        return 0;
+    }
+    #else
+    if (memcmp(expected, actual, 32) == 0)
+    {
+        return 0;
+    }
+    #endif
+    for (uint8_t iter = 0; iter < 32; ++iter)
+    {
+        if (expected[iter] != actual[iter])
+        {
+            differenceMask |= UINT32_C(1) << iter;
+        }
+    }
+    return differenceMask;
+#endif
+}
+
+#if defined (OPENSEA_CPU_X86)
+//compares 64 bytes per loop with a single branch. Returns how many bytes were compared.
+OPENSEA_TARGET("avx2")
+static size_t verify_Chunk_AVX2(ptrPatternVerifyResult result, const uint8_t *expected, const uint8_t *actual, size_t length, uint64_t baseOffset)
+{
+    size_t offset = 0;
+    for (; offset + 64 <= length; offset += 64)
+    {
+        __m256i equalLow = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&expected[offset]), _mm256_loadu_si256((const __m256i*)&actual[offset]));
+        __m256i equalHigh = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&expected[offset + 32]), _mm256_loadu_si256((const __m256i*)&actual[offset + 32]));
+        if (!_mm256_testc_si256(_mm256_and_si256(equalLow, equalHigh), _mm256_set1_epi8(-1)))
+        {
+            uint32_t lowMask = ~(uint32_t)_mm256_movemask_epi8(equalLow);
+            uint32_t highMask = ~(uint32_t)_mm256_movemask_epi8(equalHigh);
+            if (lowMask)
+            {
+                record_Verify_Differences(result, lowMask, baseOffset + offset);
+            }
+            if (highMask)
+            {
+                record_Verify_Differences(result, highMask, baseOffset + offset + 32);
+            }
+        }
+    }
+    return offset;
+}
+#endif
+
+static void verify_Chunk(ptrPatternVerifyResult result, const uint8_t *expected, const uint8_t *actual, size_t length, uint64_t baseOffset)
+{
+    size_t offset = 0;
+#if defined (OPENSEA_CPU_X86)
+    if (get_CPU_Features() & CPU_FEATURE_AVX2)
+    {
+        offset = verify_Chunk_AVX2(result, expected, actual, length, baseOffset);
+    }
+#endif
+    for (; offset + 32 <= length; offset += 32)
+    {
+        uint32_t differenceMask = compare_32_Bytes(&expected[offset], &actual[offset]);
+        if (differenceMask)
+        {
+            record_Verify_Differences(result, differenceMask, baseOffset + offset);
+        }
+    }
+    if (offset < length)
+    {
+        uint32_t differenceMask = 0;
+        for (uint8_t iter = 0; offset + iter < length; ++iter)
+        {
+            if (expected[offset + iter] != actual[offset + iter])
+            {
+                differenceMask |= UINT32_C(1) << iter;
+            }
+        }
+        if (differenceMask)
+        {
+            record_Verify_Differences(result, differenceMask, baseOffset + offset);
+        }
+    }
+}
+
+//checks parameters and clears the result before a verify starts
+static int start_Pattern_Verify(const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    if (!result || (!ptrData && dataLength > 0) || (result->sectorBitmapSize > 0 && !result->sectorBitmap))
+    {
+        return BAD_PARAMETER;
+    }
+    if (result->sectorSize == 0)
+    {
+        result->sectorSize = PATTERN_VERIFY_DEFAULT_SECTOR_SIZE;
+    }
+    if (result->sectorBitmap)
+    {
+        memset(result->sectorBitmap, 0, result->sectorBitmapSize);
+    }
+    result->differentBytes = 0;
+    result->differentSectors = 0;
+    result->firstDifferenceOffset = 0;
+    result->lastDifferentSector = 0;
+    return SUCCESS;
+}
+
+//repeating patterns are expanded into a chunk starting at the pattern offset of each chunk and compared
+static int verify_Repeating_Pattern(const uint8_t *pattern, size_t patternLength, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    uint8_t expected[PATTERN_VERIFY_CHUNK_SIZE];
+    int ret = start_Pattern_Verify(ptrData, dataLength, result);
+    if (ret != SUCCESS || !pattern || patternLength == 0)
+    {
+        return ret != SUCCESS ? ret : BAD_PARAMETER;
+    }
+    for (size_t offset = 0; offset < dataLength; offset += PATTERN_VERIFY_CHUNK_SIZE)
+    {
+        size_t chunkLength = M_Min(PATTERN_VERIFY_CHUNK_SIZE, dataLength - offset);
+        size_t patternOffset = offset % patternLength;
+        size_t expectedLength = M_Min(patternLength - patternOffset, chunkLength);
+        //one copy of the pattern from where this chunk starts in it, then keep doubling what is there
+        memcpy(expected, &pattern[patternOffset], expectedLength);
+        if (expectedLength < chunkLength)
+        {
+            size_t copyLength = M_Min(patternOffset, chunkLength - expectedLength);
+            memcpy(&expected[expectedLength], pattern, copyLength);
+            expectedLength += copyLength;
+        }
+        while (expectedLength < chunkLength)
+        {
+            size_t copyLength = M_Min(expectedLength, chunkLength - expectedLength);
+            memcpy(&expected[expectedLength], expected, copyLength);
+            expectedLength += copyLength;
+        }
+        verify_Chunk(result, expected, &ptrData[offset], chunkLength, offset);
+    }
+    return result->differentBytes > 0 ? FAILURE : SUCCESS;
+}
+
+int verify_Hex_Pattern_In_Buffer(uint32_t hexPattern, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    return verify_Repeating_Pattern((const uint8_t*)&hexPattern, sizeof(uint32_t), ptrData, dataLength, result);
+}
+
+int verify_Incrementing_Pattern_In_Buffer(uint8_t incrementStartValue, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    uint8_t pattern[UINT8_MAX + 1];
+    for (uint16_t iter = 0; iter <= UINT8_MAX; ++iter)
+    {
+        pattern[iter] = (uint8_t)(incrementStartValue + iter);
+    }
+    return verify_Repeating_Pattern(pattern, sizeof(pattern), ptrData, dataLength, result);
+}
+
+int verify_ASCII_Pattern_In_Buffer(const char *asciiPattern, uint32_t patternLength, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    return verify_Repeating_Pattern((const uint8_t*)asciiPattern, patternLength, ptrData, dataLength, result);
+}
+
+int verify_Pattern_Buffer_In_Another_Buffer(const uint8_t *inPattern, uint32_t inpatternLength, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    return verify_Repeating_Pattern(inPattern, inpatternLength, ptrData, dataLength, result);
+}
+
+int verify_Seeded_Random_Pattern_In_Buffer(uint64_t seed, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    uint8_t expected[PATTERN_VERIFY_CHUNK_SIZE];
+    randomFillState fillState;
+    int ret = start_Pattern_Verify(ptrData, dataLength, result);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    for (size_t offset = 0; offset < dataLength; offset += PATTERN_VERIFY_CHUNK_SIZE)
+    {
+        size_t chunkLength = M_Min(PATTERN_VERIFY_CHUNK_SIZE, dataLength - offset);
+        if (offset % RANDOM_FILL_SEGMENT_SIZE == 0)
+        {
+            seed_Random_Fill_Segment(&fillState, seed, offset / RANDOM_FILL_SEGMENT_SIZE);
+        }
+        fill_Random_Pattern_From_State(&fillState, expected, chunkLength);
+        verify_Chunk(result, expected, &ptrData[offset], chunkLength, offset);
+    }
+    return result->differentBytes > 0 ? FAILURE : SUCCESS;
+}
+
+//Seekable random data is splitmix64 run as a counter: the 8 byte word at stream offset N * 8 is the splitmix64 mix of key + N * SPLITMIX64_INCREMENT.
+//The key is made from the seed so that seeds next to each other do not give shifted copies of the same stream.
+static uint64_t get_Seekable_Random_Key(uint64_t seed)
+{
+    return splitmix64(&seed);
+}
+
+static uint64_t get_Seekable_Random_Word(uint64_t key, uint64_t wordIndex)
+{
+    uint64_t result = key + wordIndex * SPLITMIX64_INCREMENT;
+    result = (result ^ (result >> 30)) * SPLITMIX64_MULTIPLIER_1;
+    result = (result ^ (result >> 27)) * SPLITMIX64_MULTIPLIER_2;
+    return result ^ (result >> 31);
+}
+
+#if defined (OPENSEA_CPU_X86)
+//AVX2 only has a 32x32 bit multiply, so the 64bit multiply by a constant is built from three of them
+#define AVX2_MULTIPLY_64(value, constant, constantHigh) \
+    _mm256_add_epi64(_mm256_mul_epu32(value, constant), _mm256_slli_epi64(_mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(value, 32), constant), _mm256_mul_epu32(value, constantHigh)), 32))
+
+//makes 8 words (64 bytes) per loop as two sets of 4 counters. Returns how many words were made.
+OPENSEA_TARGET("avx2")
+static size_t fill_Seekable_Words_AVX2(uint64_t key, uint64_t firstWord, uint8_t *ptrData, size_t wordCount)
+{
+    size_t word = 0;
+    __m256i multiplier1 = _mm256_set1_epi64x((long long)SPLITMIX64_MULTIPLIER_1);
+    __m256i multiplier1High = _mm256_set1_epi64x((long long)(SPLITMIX64_MULTIPLIER_1 >> 32));
+    __m256i multiplier2 = _mm256_set1_epi64x((long long)SPLITMIX64_MULTIPLIER_2);
+    __m256i multiplier2High = _mm256_set1_epi64x((long long)(SPLITMIX64_MULTIPLIER_2 >> 32));
+    __m256i step = _mm256_set1_epi64x((long long)(8 * SPLITMIX64_INCREMENT));
+    uint64_t start = key + firstWord * SPLITMIX64_INCREMENT;
+    __m256i counterLow = _mm256_set_epi64x((long long)(start + 3 * SPLITMIX64_INCREMENT), (long long)(start + 2 * SPLITMIX64_INCREMENT), (long long)(start + SPLITMIX64_INCREMENT), (long long)start);
+    __m256i counterHigh = _mm256_add_epi64(counterLow, _mm256_set1_epi64x((long long)(4 * SPLITMIX64_INCREMENT)));
+    for (; word + 8 <= wordCount; word += 8)
+    {
+        __m256i low = _mm256_xor_si256(counterLow, _mm256_srli_epi64(counterLow, 30));
+        __m256i high = _mm256_xor_si256(counterHigh, _mm256_srli_epi64(counterHigh, 30));
+        low = AVX2_MULTIPLY_64(low, multiplier1, multiplier1High);
+        high = AVX2_MULTIPLY_64(high, multiplier1, multiplier1High);
+        low = _mm256_xor_si256(low, _mm256_srli_epi64(low, 27));
+        high = _mm256_xor_si256(high, _mm256_srli_epi64(high, 27));
+        low = AVX2_MULTIPLY_64(low, multiplier2, multiplier2High);
+        high = AVX2_MULTIPLY_64(high, multiplier2, multiplier2High);
+        low = _mm256_xor_si256(low, _mm256_srli_epi64(low, 31));
+        high = _mm256_xor_si256(high, _mm256_srli_epi64(high, 31));
+        _mm256_storeu_si256((__m256i*)&ptrData[word * sizeof(uint64_t)], low);
+        _mm256_storeu_si256((__m256i*)&ptrData[word * sizeof(uint64_t) + 32], high);
+        counterLow = _mm256_add_epi64(counterLow, step);
+        counterHigh = _mm256_add_epi64(counterHigh, step);
+    }
+    return word;
+}
+#endif
+
+int fill_Seekable_Random_Pattern_In_Buffer(uint64_t seed, uint64_t streamOffset, uint8_t *ptrData, size_t dataLength)
+{
+    uint64_t key = get_Seekable_Random_Key(seed);
+    uint64_t wordIndex = streamOffset / sizeof(uint64_t);
+    size_t wordCount = 0;
+    size_t word = 0;
+    size_t offset = 0;
+    if (!ptrData && dataLength > 0)
+    {
+        return BAD_PARAMETER;
+    }
+    if (streamOffset % sizeof(uint64_t) && dataLength > 0)
+    {
+        //starts part way into a word
+        uint64_t value = get_Seekable_Random_Word(key, wordIndex++);
+        offset = M_Min(sizeof(uint64_t) - streamOffset % sizeof(uint64_t), dataLength);
+        memcpy(ptrData, (uint8_t*)&value + streamOffset % sizeof(uint64_t), offset);
+    }
+    wordCount = (dataLength - offset) / sizeof(uint64_t);
+#if defined (OPENSEA_CPU_X86)
+    if (get_CPU_Features() & CPU_FEATURE_AVX2)
+    {
+        word = fill_Seekable_Words_AVX2(key, wordIndex, &ptrData[offset], wordCount);
+    }
+#endif
+    for (; word < wordCount; ++word)
+    {
+        uint64_t value = get_Seekable_Random_Word(key, wordIndex + word);
+        memcpy(&ptrData[offset + word * sizeof(uint64_t)], &value, sizeof(uint64_t));
+    }
+    offset += wordCount * sizeof(uint64_t);
+    if (offset < dataLength)
+    {
+        uint64_t value = get_Seekable_Random_Word(key, wordIndex + wordCount);
+        memcpy(&ptrData[offset], &value, dataLength - offset);
+    }
+    return SUCCESS;
+}
+
+int verify_Seekable_Random_Pattern_In_Buffer(uint64_t seed, uint64_t streamOffset, const uint8_t *ptrData, size_t dataLength, ptrPatternVerifyResult result)
+{
+    uint8_t expected[PATTERN_VERIFY_CHUNK_SIZE];
+    int ret = start_Pattern_Verify(ptrData, dataLength, result);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    for (size_t offset = 0; offset < dataLength; offset += PATTERN_VERIFY_CHUNK_SIZE)
+    {
+        size_t chunkLength = M_Min(PATTERN_VERIFY_CHUNK_SIZE, dataLength - offset);
+        fill_Seekable_Random_Pattern_In_Buffer(seed, streamOffset + offset, expected, chunkLength);
+        verify_Chunk(result, expected, &ptrData[offset], chunkLength, offset);
+    }
+    return result->differentBytes > 0 ? FAILURE : SUCCESS;
+}
+
+#define TAGGED_SECTOR_SIGNATURE UINT32_C(0x47415453) //"STAG" in little endian
+
+//header layout. Each field is stored in little endian byte order so sectors verify on any host.
+#define TAGGED_SECTOR_SIGNATURE_OFFSET 0
+#define TAGGED_SECTOR_PASS_OFFSET 4
+#define TAGGED_SECTOR_LBA_OFFSET 8
+#define TAGGED_SECTOR_SEED_OFFSET 16
+#define TAGGED_SECTOR_SIZE_OFFSET 24
+#define TAGGED_SECTOR_CHECKSUM_OFFSET 28
+
+typedef struct _taggedSectorTag
+{
+    uint32_t signature;
+    uint32_t pass;
+    uint64_t lba;
+    uint64_t seed;
+    uint32_t sectorSize;
+    uint32_t checksum;
+}taggedSectorTag;
+
+static void write_Tagged_Sector_Header(uint8_t *header, const taggedSectorTag *tag)
+{
+    store_Little_Endian_32(&header[TAGGED_SECTOR_SIGNATURE_OFFSET], tag->signature);
+    store_Little_Endian_32(&header[TAGGED_SECTOR_PASS_OFFSET], tag->pass);
+    store_Little_Endian_64(&header[TAGGED_SECTOR_LBA_OFFSET], tag->lba);
+    store_Little_Endian_64(&header[TAGGED_SECTOR_SEED_OFFSET], tag->seed);
+    store_Little_Endian_32(&header[TAGGED_SECTOR_SIZE_OFFSET], tag->sectorSize);
+    store_Little_Endian_32(&header[TAGGED_SECTOR_CHECKSUM_OFFSET], tag->checksum);
+}
+
+//CRC32C of the header bytes before the checksum, as they are written to the sector
+static uint32_t get_Tagged_Sector_Checksum(const taggedSectorTag *tag)
+{
+    uint8_t header[TAGGED_SECTOR_HEADER_SIZE] = { 0 };
+    write_Tagged_Sector_Header(header, tag);
+    return update_CRC32C(CRC32C_START_VALUE, header, TAGGED_SECTOR_CHECKSUM_OFFSET);
+}
+
+static void read_Tagged_Sector_Header(const uint8_t *header, taggedSectorTag *tag)
+{
+    tag->signature = load_Little_Endian_32(&header[TAGGED_SECTOR_SIGNATURE_OFFSET]);
+    tag->pass = load_Little_Endian_32(&header[TAGGED_SECTOR_PASS_OFFSET]);
+    tag->lba = load_Little_Endian_64(&header[TAGGED_SECTOR_LBA_OFFSET]);
+    tag->seed = load_Little_Endian_64(&header[TAGGED_SECTOR_SEED_OFFSET]);
+    tag->sectorSize = load_Little_Endian_32(&header[TAGGED_SECTOR_SIZE_OFFSET]);
+    tag->checksum = load_Little_Endian_32(&header[TAGGED_SECTOR_CHECKSUM_OFFSET]);
+}
+
+static void make_Tagged_Sector_Tag(taggedSectorTag *tag, uint64_t seed, uint32_t pass, uint64_t lba, uint32_t sectorSize)
+{
+    tag->signature = TAGGED_SECTOR_SIGNATURE;
+    tag->pass = pass;
+    tag->lba = lba;
+    tag->seed = seed;
+    tag->sectorSize = sectorSize;
+    tag->checksum = 0;
+    tag->checksum = get_Tagged_Sector_Checksum(tag);
+}
+
+//The payload is the seekable random stream at the sector's own position, keyed by the seed and pass so data from another pass never matches
+static void fill_Tagged_Sector_Payload(const taggedSectorTag *tag, uint32_t payloadOffset, uint8_t *ptrData, size_t dataLength)
+{
+    uint64_t payloadSeed = tag->seed + (uint64_t)tag->pass * SPLITMIX64_INCREMENT;
+    fill_Seekable_Random_Pattern_In_Buffer(payloadSeed, tag->lba * tag->sectorSize + TAGGED_SECTOR_HEADER_SIZE + payloadOffset, ptrData, dataLength);
+}
+
+//compares the payload of a sector with what the tag says it should be, a chunk at a time
+static bool tagged_Sector_Payload_Matches(const taggedSectorTag *tag, const uint8_t *sector, uint8_t *scratch)
+{
+    uint32_t payloadLength = tag->sectorSize - TAGGED_SECTOR_HEADER_SIZE;
+    for (uint32_t offset = 0; offset < payloadLength; offset += PATTERN_VERIFY_CHUNK_SIZE)
+    {
+        uint32_t chunkLength = M_Min(PATTERN_VERIFY_CHUNK_SIZE, payloadLength - offset);
+        fill_Tagged_Sector_Payload(tag, offset, scratch, chunkLength);
+        if (memcmp(scratch, &sector[TAGGED_SECTOR_HEADER_SIZE + offset], chunkLength) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int fill_Tagged_Sector_Pattern_In_Buffer(uint64_t seed, uint32_t pass, uint64_t firstLBA, uint32_t sectorSize, uint8_t *ptrData, size_t dataLength)
+{
+    if (!ptrData || sectorSize <= TAGGED_SECTOR_HEADER_SIZE || dataLength % sectorSize)
+    {
+        return BAD_PARAMETER;
+    }
+    for (size_t offset = 0; offset < dataLength; offset += sectorSize)
+    {
+        taggedSectorTag tag;
+        make_Tagged_Sector_Tag(&tag, seed, pass, firstLBA + offset / sectorSize, sectorSize);
+        write_Tagged_Sector_Header(&ptrData[offset], &tag);
+        fill_Tagged_Sector_Payload(&tag, 0, &ptrData[offset + TAGGED_SECTOR_HEADER_SIZE], sectorSize - TAGGED_SECTOR_HEADER_SIZE);
+    }
+    return SUCCESS;
+}
+
+//Works out why a sector does not match. The tag in the sector is trusted only when its checksum is right and the payload matches what that tag describes.
+static eTaggedSectorStatus classify_Tagged_Sector(const taggedSectorTag *expectedTag, const uint8_t *sector, uint8_t *scratch)
+{
+    taggedSectorTag foundTag;
+    read_Tagged_Sector_Header(sector, &foundTag);
+    if (foundTag.signature != TAGGED_SECTOR_SIGNATURE || foundTag.sectorSize != expectedTag->sectorSize || foundTag.checksum != get_Tagged_Sector_Checksum(&foundTag)
+        || !tagged_Sector_Payload_Matches(&foundTag, sector, scratch))
+    {
+        return TAGGED_SECTOR_CORRUPTED;
+    }
+    if (foundTag.lba != expectedTag->lba)
+    {
+        return TAGGED_SECTOR_MISDIRECTED;
+    }
+    if (foundTag.pass != expectedTag->pass || foundTag.seed != expectedTag->seed)
+    {
+        return TAGGED_SECTOR_STALE;
+    }
+    //header and payload are both exactly what was expected
+    return TAGGED_SECTOR_GOOD;
+}
+
+int verify_Tagged_Sector_Pattern_In_Buffer(uint64_t seed, uint32_t pass, uint64_t firstLBA, uint32_t sectorSize, const uint8_t *ptrData, size_t dataLength, ptrTaggedSectorVerifyResult result)
+{
+    uint8_t scratch[PATTERN_VERIFY_CHUNK_SIZE];
+    if (!ptrData || !result || sectorSize <= TAGGED_SECTOR_HEADER_SIZE || dataLength % sectorSize || (result->sectorStatusCount > 0 && !result->sectorStatus))
+    {
+        return BAD_PARAMETER;
+    }
+    result->goodSectors = 0;
+    result->misdirectedSectors = 0;
+    result->staleSectors = 0;
+    result->corruptedSectors = 0;
+    result->firstBadLBA = 0;
+    for (size_t offset = 0; offset < dataLength; offset += sectorSize)
+    {
+        uint64_t sectorNumber = offset / sectorSize;
+        eTaggedSectorStatus status = TAGGED_SECTOR_GOOD;
+        uint8_t expectedHeader[TAGGED_SECTOR_HEADER_SIZE];
+        taggedSectorTag expectedTag;
+        make_Tagged_Sector_Tag(&expectedTag, seed, pass, firstLBA + sectorNumber, sectorSize);
+        write_Tagged_Sector_Header(expectedHeader, &expectedTag);
+        if (memcmp(expectedHeader, &ptrData[offset], TAGGED_SECTOR_HEADER_SIZE) != 0 || !tagged_Sector_Payload_Matches(&expectedTag, &ptrData[offset], scratch))
+        {
+            status = classify_Tagged_Sector(&expectedTag, &ptrData[offset], scratch);
+        }
+        switch (status)
+        {
+        case TAGGED_SECTOR_GOOD:
+            ++result->goodSectors;
+            break;
+        case TAGGED_SECTOR_MISDIRECTED:
+            ++result->misdirectedSectors;
+            break;
+        case TAGGED_SECTOR_STALE:
+            ++result->staleSectors;
+            break;
+        case TAGGED_SECTOR_CORRUPTED:
+            ++result->corruptedSectors;
+            break;
+        }
+        if (status != TAGGED_SECTOR_GOOD && result->goodSectors == sectorNumber)
+        {
+            result->firstBadLBA = expectedTag.lba;
+        }
+        if (sectorNumber < result->sectorStatusCount)
+        {
+            result->sectorStatus[sectorNumber] = status;
+        }
+    }
+    return result->goodSectors == dataLength / sectorSize ? SUCCESS : FAILURE;
+}
+
+//Writes bytes blockOffset to blockOffset + length - 1 of a block. Byte N of a block is byte (N % randomLength) of the block's random data,
+//which is the seekable stream starting at streamStart.
+static void fill_Entropy_Block(uint64_t seed, uint64_t streamStart, size_t randomLength, size_t blockOffset, uint8_t *ptrData, size_t length)
+{
+    size_t offset = 0;
+    if (blockOffset < randomLength)
+    {
+        offset = M_Min(randomLength - blockOffset, length);
+        fill_Seekable_Random_Pattern_In_Buffer(seed, streamStart + blockOffset, ptrData, offset);
+    }
+    if (offset < length)
+    {
+        if (offset < randomLength)
+        {
+            //starts in the repeats without the random data in front of it, so make one copy of it at the right phase
+            size_t phase = (blockOffset + offset) % randomLength;
+            size_t firstPart = M_Min(randomLength - phase, length - offset);
+            fill_Seekable_Random_Pattern_In_Buffer(seed, streamStart + phase, &ptrData[offset], firstPart);
+            fill_Seekable_Random_Pattern_In_Buffer(seed, streamStart, &ptrData[offset + firstPart], M_Min(phase, length - offset - firstPart));
+            offset += M_Min(randomLength, length - offset);
+        }
+        if (offset < length)
+        {
+            fill_Repeating_Pattern_In_Buffer(&ptrData[offset - randomLength], randomLength, &ptrData[offset], length - offset);
+        }
+    }
+}
+
+int fill_Entropy_Pattern_In_Buffer(const entropyPatternSettings *settings, uint64_t streamOffset, uint8_t *ptrData, size_t dataLength)
+{
+    uint32_t blockSize = 0;
+    uint32_t compressionRatio = 0;
+    uint32_t dedupRatio = 0;
+    size_t randomLength = 0;
+    uint64_t uniqueBlocks = 0;//in each dedup group
+    size_t offset = 0;
+    if (!settings || (!ptrData && dataLength > 0) || settings->blockSize > ENTROPY_PATTERN_MAX_BLOCK_SIZE)
+    {
+        return BAD_PARAMETER;
+    }
+    blockSize = settings->blockSize ? settings->blockSize : ENTROPY_PATTERN_DEFAULT_BLOCK_SIZE;
+    compressionRatio = M_Max(settings->compressionRatioPercent, UINT32_C(100));
+    dedupRatio = M_Max(settings->dedupRatioPercent, UINT32_C(100));
+    randomLength = (size_t)M_Max((uint64_t)blockSize * 100 / compressionRatio, UINT64_C(1));
+    uniqueBlocks = M_Max((ENTROPY_PATTERN_DEDUP_WINDOW * UINT64_C(100) + dedupRatio / 2) / dedupRatio, UINT64_C(1));
+    while (offset < dataLength)
+    {
+        uint64_t block = (streamOffset + offset) / blockSize;
+        size_t blockOffset = (size_t)((streamOffset + offset) % blockSize);
+        size_t length = M_Min(blockSize - blockOffset, dataLength - offset);
+        //blocks N, N + uniqueBlocks, N + 2 * uniqueBlocks... of a group have the same content
+        uint64_t content = (block / ENTROPY_PATTERN_DEDUP_WINDOW) * uniqueBlocks + (block % ENTROPY_PATTERN_DEDUP_WINDOW) % uniqueBlocks;
+        fill_Entropy_Block(settings->seed, content * blockSize, randomLength, blockOffset, &ptrData[offset], length);
+        offset += length;
+    }
+    return SUCCESS;
+}
+
+static void add_Sector_Run(ptrZeroScanResult result, uint64_t firstSector, uint64_t sectorCount, bool zero)
+{
+    if (result->runCount < result->runCapacity && result->runs)
+    {
+        result->runs[result->runCount].firstSector = result->firstSector + firstSector;
+        result->runs[result->runCount].sectorCount = sectorCount;
+        result->runs[result->runCount].zero = zero;
+    }
+    ++result->runCount;
+    if (zero)
+    {
+        result->zeroSectors += sectorCount;
+    }
+    else
+    {
+        result->nonzeroSectors += sectorCount;
+    }
+}
+
+int scan_Zero_Sectors(const uint8_t *ptrData, size_t dataLength, ptrZeroScanResult result)
+{
+    size_t sectorSize = 0;
+    uint64_t sectorCount = 0;
+    uint64_t sector = 0;
+    if (!result || (!ptrData && dataLength > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    sectorSize = result->sectorSize ? result->sectorSize : PATTERN_VERIFY_DEFAULT_SECTOR_SIZE;
+    sectorCount = (dataLength + sectorSize - 1) / sectorSize;
+    result->runCount = 0;
+    result->zeroSectors = 0;
+    result->nonzeroSectors = 0;
+    result->firstNonzeroOffset = 0;
+    while (sector < sectorCount)
+    {
+        //zero run: everything up to the sector holding the next nonzero byte
+        size_t offset = (size_t)(sector * sectorSize);
+        size_t nonzeroOffset = offset + find_First_Nonzero_Byte(&ptrData[offset], dataLength - offset);
+        uint64_t nonzeroSector = nonzeroOffset == dataLength ? sectorCount : nonzeroOffset / sectorSize;
+        uint64_t runStart = 0;
+        if (nonzeroSector > sector)
+        {
+            add_Sector_Run(result, sector, nonzeroSector - sector, true);
+        }
+        if (nonzeroSector == sectorCount)
+        {
+            break;
+        }
+        if (result->nonzeroSectors == 0)
+        {
+            result->firstNonzeroOffset = nonzeroOffset;
+        }
+        //nonzero run: until a sector that is all zeros
+        runStart = nonzeroSector;
+        for (sector = nonzeroSector + 1; sector < sectorCount; ++sector)
+        {
+            size_t sectorOffset = (size_t)(sector * sectorSize);
+            size_t length = M_Min(sectorSize, dataLength - sectorOffset);
+            if (find_First_Nonzero_Byte(&ptrData[sectorOffset], length) == length)
+            {
+                break;
+            }
+        }
+        add_Sector_Run(result, runStart, sector - runStart, false);
+    }
+    return result->nonzeroSectors ? FAILURE : SUCCESS;
+}
+
+typedef struct _zeroMapJob
+{
+    const uint8_t *ptrData;//start of the whole buffer
+    size_t dataLength;
+    size_t regionSize;
+    uint8_t *bitmap;//whole bitmap. Chunks start on a multiple of 8 regions, so each chunk has bytes of it to itself.
+    struct
+    {
+        uint64_t nonzeroRegions;
+        uint64_t firstNonzeroOffset;//only valid when nonzeroRegions is not 0
+    }chunkResults[PATTERN_MAX_THREADS];//one for each chunk, set by the thread doing it
+}zeroMapJob;
+
+//chunk units are regions
+static void map_Nonzero_Chunk(const patternThreadChunk *chunk)
+{
+    zeroMapJob *job = (zeroMapJob*)chunk->job;
+    uint64_t nonzeroRegions = 0;
+    for (uint64_t region = chunk->firstUnit; region < chunk->firstUnit + chunk->unitCount; ++region)
+    {
+        size_t offset = (size_t)(region * job->regionSize);
+        size_t length = M_Min(job->regionSize, job->dataLength - offset);
+        size_t nonzeroOffset = find_First_Nonzero_Byte(&job->ptrData[offset], length);
+        if (nonzeroOffset < length)
+        {
+            if (nonzeroRegions == 0)
+            {
+                job->chunkResults[chunk->chunkIndex].firstNonzeroOffset = offset + nonzeroOffset;
+            }
+            ++nonzeroRegions;
+            job->bitmap[region / BITSPERBYTE] |= (uint8_t)(1 << (region % BITSPERBYTE));
+        }
+    }
+    job->chunkResults[chunk->chunkIndex].nonzeroRegions = nonzeroRegions;
+}
+
+//Builds the extents from the bitmap after the threads are done. The bitmap is much smaller than the data, and whole bytes of it are skipped at a time.
+static void build_Nonzero_Extents(ptrZeroRegionMap map, const uint8_t *bitmap, uint64_t regionCount, size_t regionSize, size_t dataLength)
+{
+    size_t bitmapLength = (size_t)((regionCount + BITSPERBYTE - 1) / BITSPERBYTE);
+    uint64_t region = 0;
+    while (region < regionCount)
+    {
+        uint64_t runStart = 0;
+        size_t byteOffset = (size_t)(region / BITSPERBYTE);
+        if (!(bitmap[byteOffset] >> (region % BITSPERBYTE)))
+        {
+            //nothing else set in this byte, so skip to the next byte with a bit set
+            byteOffset += 1 + find_First_Nonzero_Byte(&bitmap[byteOffset + 1], bitmapLength - byteOffset - 1);
+            region = (uint64_t)byteOffset * BITSPERBYTE;
+            continue;
+        }
+        while (!(bitmap[region / BITSPERBYTE] & (1 << (region % BITSPERBYTE))))
+        {
+            ++region;
+        }
+        runStart = region;
+        while (region < regionCount && (bitmap[region / BITSPERBYTE] & (1 << (region % BITSPERBYTE))))
+        {
+            ++region;
+        }
+        if (map->extentCount < map->extentCapacity && map->extents)
+        {
+            map->extents[map->extentCount].offset = runStart * regionSize;
+            map->extents[map->extentCount].length = M_Min(region * regionSize, (uint64_t)dataLength) - runStart * regionSize;
+        }
+        ++map->extentCount;
+    }
+}
+
+int map_Nonzero_Regions(const uint8_t *ptrData, size_t dataLength, uint32_t threadCount, ptrZeroRegionMap map)
+{
+    zeroMapJob job;
+    size_t regionSize = 0;
+    uint64_t regionCount = 0;
+    size_t bitmapLength = 0;
+    uint8_t *bitmap = NULL;
+    uint32_t chunkCount = 0;
+    if (!map || (!ptrData && dataLength > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    regionSize = map->regionSize ? map->regionSize : ZERO_MAP_DEFAULT_REGION_SIZE;
+    regionCount = (dataLength + regionSize - 1) / regionSize;
+    bitmapLength = (size_t)((regionCount + BITSPERBYTE - 1) / BITSPERBYTE);
+    map->extentCount = 0;
+    map->nonzeroRegions = 0;
+    map->firstNonzeroOffset = 0;
+    if (map->bitmap)
+    {
+        memset(map->bitmap, 0, map->bitmapSize);
+    }
+    //the threads need a bitmap that covers everything
+    if (map->bitmap && map->bitmapSize >= bitmapLength)
+    {
+        bitmap = map->bitmap;
+    }
+    else if (bitmapLength > 0)
+    {
+        bitmap = (uint8_t*)calloc(bitmapLength, sizeof(uint8_t));
+        if (!bitmap)
+        {
+            return MEMORY_FAILURE;
+        }
+    }
+    memset(&job, 0, sizeof(zeroMapJob));
+    job.ptrData = ptrData;
+    job.dataLength = dataLength;
+    job.regionSize = regionSize;
+    job.bitmap = bitmap;
+    chunkCount = run_Pattern_Threads(map_Nonzero_Chunk, &job, regionCount, BITSPERBYTE, dataLength, threadCount);
+    for (uint32_t iter = 0; iter < chunkCount; ++iter)
+    {
+        if (job.chunkResults[iter].nonzeroRegions > 0 && map->nonzeroRegions == 0)
+        {
+            map->firstNonzeroOffset = job.chunkResults[iter].firstNonzeroOffset;
+        }
+        map->nonzeroRegions += job.chunkResults[iter].nonzeroRegions;
+    }
+    if (map->nonzeroRegions > 0)
+    {
+        build_Nonzero_Extents(map, bitmap, regionCount, regionSize, dataLength);
+    }
+    if (bitmap && bitmap != map->bitmap)
+    {
+        if (map->bitmap)
+        {
+            memcpy(map->bitmap, bitmap, map->bitmapSize);
+        }
+        safe_Free(bitmap);
+    }
+    return map->nonzeroRegions ? FAILURE : SUCCESS;
+}
+
+int map_Nonzero_Regions_In_File(FILE *filePtr, uint32_t threadCount, ptrZeroRegionMap map)
+{
+    seaFileMapping mapping;
+    int ret = SUCCESS;
+    if (!filePtr || !map)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = os_Map_File(filePtr, &mapping);
+    if (ret != SUCCESS)
+    {
+        return ret == NOT_SUPPORTED ? NOT_SUPPORTED : FAILURE;
+    }
+    ret = map_Nonzero_Regions(mapping.data, (size_t)mapping.length, threadCount, map);
+    os_Unmap_File(&mapping);
+    return ret;
+}
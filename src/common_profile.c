@@ -0,0 +1,275 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012 - 2019 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file common_profile.c
+// \brief Implements profiling zones that record where time is spent, and writes them as a Chrome trace for chrome://tracing or Perfetto
+//
+//Each thread that profiles owns a buffer of events that only it writes. count is stored after the event it covers,
+//so write_Profile_Trace can read every buffer up to its count while the threads keep recording.
+#include "common_profile.h"
+#include "common_output.h"
+
+#define PROFILE_TRACE_PROCESS_ID 1 //all threads are shown under one process in the trace
+
+typedef struct _profileEvent
+{
+    uint64_t timestamp;//same units as seatimer_t.timerStart
+    const char *name;//NULL for the end of a zone
+}profileEvent;
+
+typedef struct _profileBuffer
+{
+    struct _profileBuffer *next;//buffers are only added to the list, never removed, until stop_Profiling
+    volatile uint32_t owned;//1 while a thread is using this buffer
+    uint32_t threadId;//tid in the trace
+    uint32_t capacity;
+    uint32_t openZones;//zones begun but not ended. This many events are always kept free for their ends.
+    uint32_t droppedDepth;//dropped zones that have not ended, so their ends are dropped too
+    volatile uint32_t dropped;
+    volatile uint32_t count;//events recorded. Only changed by the owning thread.
+    profileEvent *events;
+}profileBuffer;
+
+static struct _profileState
+{
+    volatile uint32_t running;
+    volatile uint32_t generation;//changes every start so that threads notice their old buffer is gone
+    profileBuffer * volatile buffers;
+    volatile uint32_t bufferCount;
+    uint32_t eventsPerThread;
+    uint64_t startTimestamp;//trace times are from here
+}profileState;
+
+static OPENSEA_THREAD_LOCAL profileBuffer *threadProfileBuffer = NULL;
+static OPENSEA_THREAD_LOCAL uint32_t threadProfileGeneration = 0;
+
+static uint64_t read_Profile_Timestamp(void)
+{
+    seatimer_t timestamp;
+    memset(&timestamp, 0, sizeof(seatimer_t));
+    start_Timer(&timestamp);
+    return timestamp.timerStart;
+}
+
+//Gets this thread's buffer, reusing a released buffer or adding a new one the first time a thread begins a zone
+static profileBuffer* get_Thread_Profile_Buffer(void)
+{
+    profileBuffer *buffer = NULL;
+    profileBuffer *listHead = NULL;
+    if (threadProfileBuffer && threadProfileGeneration == M_Atomic_Load(&profileState.generation))
+    {
+        return threadProfileBuffer;
+    }
+    for (buffer = (profileBuffer*)M_Atomic_Load_Pointer(&profileState.buffers); buffer; buffer = buffer->next)
+    {
+        if (M_Atomic_Compare_Exchange(&buffer->owned, 0, 1))
+        {
+            break;
+        }
+    }
+    if (!buffer)
+    {
+        buffer = (profileBuffer*)calloc(1, sizeof(profileBuffer));
+        if (!buffer)
+        {
+            return NULL;
+        }
+        buffer->events = (profileEvent*)malloc(sizeof(profileEvent) * profileState.eventsPerThread);
+        if (!buffer->events)
+        {
+            safe_Free(buffer);
+            return NULL;
+        }
+        buffer->capacity = profileState.eventsPerThread;
+        buffer->owned = 1;
+        buffer->threadId = M_Atomic_Increment(&profileState.bufferCount);
+        do
+        {
+            listHead = (profileBuffer*)M_Atomic_Load_Pointer(&profileState.buffers);
+            buffer->next = listHead;
+        } while (!M_Atomic_Compare_Exchange_Pointer(&profileState.buffers, listHead, buffer));
+    }
+    threadProfileBuffer = buffer;
+    threadProfileGeneration = M_Atomic_Load(&profileState.generation);
+    return buffer;
+}
+
+int start_Profiling(ptrProfileConfig config)
+{
+    if (M_Atomic_Load(&profileState.running))
+    {
+        return FAILURE;
+    }
+    profileState.eventsPerThread = (config && config->eventsPerThread > 0) ? config->eventsPerThread : PROFILE_DEFAULT_EVENTS_PER_THREAD;
+    //a zone needs room for its begin and end
+    profileState.eventsPerThread = M_Max(profileState.eventsPerThread, UINT32_C(2));
+    profileState.bufferCount = 0;
+    profileState.startTimestamp = read_Profile_Timestamp();
+    M_Atomic_Store(&profileState.generation, profileState.generation + 1);
+    M_Atomic_Store(&profileState.running, 1);
+    return SUCCESS;
+}
+
+int stop_Profiling(void)
+{
+    profileBuffer *buffer = NULL;
+    if (!M_Atomic_Compare_Exchange(&profileState.running, 1, 0))
+    {
+        return FAILURE;
+    }
+    buffer = (profileBuffer*)M_Atomic_Load_Pointer(&profileState.buffers);
+    while (buffer)
+    {
+        profileBuffer *next = buffer->next;
+        safe_Free(buffer->events);
+        safe_Free(buffer);
+        buffer = next;
+    }
+    profileState.buffers = NULL;
+    return SUCCESS;
+}
+
+void profile_Zone_Begin(const char *name)
+{
+    profileBuffer *buffer = NULL;
+    profileEvent *event = NULL;
+    if (!M_Atomic_Load(&profileState.running) || NULL == (buffer = get_Thread_Profile_Buffer()))
+    {
+        return;
+    }
+    //drop zones inside a dropped zone too, and keep room for this zone's end and the ends of the zones it is in
+    if (buffer->droppedDepth > 0 || buffer->capacity - buffer->count < buffer->openZones + 2)
+    {
+        ++buffer->droppedDepth;
+        M_Atomic_Increment(&buffer->dropped);
+        return;
+    }
+    event = &buffer->events[buffer->count];
+    event->name = name ? name : "unnamed";
+    event->timestamp = read_Profile_Timestamp();
+    ++buffer->openZones;
+    M_Atomic_Store(&buffer->count, buffer->count + 1);
+}
+
+void profile_Zone_End(void)
+{
+    profileBuffer *buffer = threadProfileBuffer;
+    profileEvent *event = NULL;
+    uint64_t timestamp = 0;
+    if (!buffer || threadProfileGeneration != M_Atomic_Load(&profileState.generation) || !M_Atomic_Load(&profileState.running))
+    {
+        //the zone's begin was not recorded in this run
+        return;
+    }
+    timestamp = read_Profile_Timestamp();
+    if (buffer->droppedDepth > 0)
+    {
+        --buffer->droppedDepth;
+        return;
+    }
+    if (buffer->openZones == 0)
+    {
+        return;
+    }
+    event = &buffer->events[buffer->count];
+    event->name = NULL;
+    event->timestamp = timestamp;
+    --buffer->openZones;
+    M_Atomic_Store(&buffer->count, buffer->count + 1);
+}
+
+void release_Profile_Thread_Buffer(void)
+{
+    if (threadProfileBuffer && threadProfileGeneration == M_Atomic_Load(&profileState.generation))
+    {
+        //the next user starts with nothing open
+        threadProfileBuffer->openZones = 0;
+        threadProfileBuffer->droppedDepth = 0;
+        M_Atomic_Store(&threadProfileBuffer->owned, 0);
+    }
+    threadProfileBuffer = NULL;
+}
+
+int write_Profile_Trace(FILE *traceFile)
+{
+    OutputInfo traceInfo;
+    ptrOutputWriter writer = NULL;
+    profileBuffer *buffer = NULL;
+    int ret = SUCCESS;
+    if (!traceFile)
+    {
+        return BAD_PARAMETER;
+    }
+    if (!M_Atomic_Load(&profileState.running))
+    {
+        return FAILURE;
+    }
+    writer = (ptrOutputWriter)calloc(1, sizeof(outputWriter));
+    if (!writer)
+    {
+        return MEMORY_FAILURE;
+    }
+    memset(&traceInfo, 0, sizeof(OutputInfo));
+    traceInfo.outputFormat = SEAC_OUTPUT_JSON;
+    traceInfo.outputFilePtr = traceFile;
+    ret = init_Output_Writer(writer, &traceInfo);
+    if (ret == SUCCESS)
+    {
+        //traces have a lot of events, so keep each one on a single line
+        writer->prettyPrint = false;
+        begin_Output_Object(writer, NULL);
+        output_String_Field(writer, "displayTimeUnit", "ns");
+        begin_Output_Array(writer, "traceEvents");
+        for (buffer = (profileBuffer*)M_Atomic_Load_Pointer(&profileState.buffers); buffer && writer->lastError == SUCCESS; buffer = buffer->next)
+        {
+            uint32_t count = M_Atomic_Load(&buffer->count);
+            for (uint32_t iter = 0; iter < count && writer->lastError == SUCCESS; ++iter)
+            {
+                const profileEvent *event = &buffer->events[iter];
+                seatimer_t sinceStart;
+                memset(&sinceStart, 0, sizeof(seatimer_t));
+                sinceStart.timerStart = profileState.startTimestamp;
+                sinceStart.timerStop = M_Max(event->timestamp, profileState.startTimestamp);
+                begin_Output_Object(writer, NULL);
+                if (event->name)
+                {
+                    output_String_Field(writer, "name", event->name);
+                    output_String_Field(writer, "ph", "B");
+                }
+                else
+                {
+                    output_String_Field(writer, "ph", "E");
+                }
+                //trace times are in microseconds
+                output_Double_Field(writer, "ts", (double)get_Nano_Seconds(sinceStart) / 1000.0);
+                output_Unsigned_Field(writer, "pid", PROFILE_TRACE_PROCESS_ID);
+                output_Unsigned_Field(writer, "tid", buffer->threadId);
+                end_Output_Object(writer);
+            }
+        }
+        end_Output_Array(writer);
+        end_Output_Object(writer);
+        ret = finish_Output_Writer(writer);
+    }
+    safe_Free(writer);
+    return ret;
+}
+
+uint64_t get_Profile_Dropped_Count(void)
+{
+    uint64_t dropped = 0;
+    profileBuffer *buffer = (profileBuffer*)M_Atomic_Load_Pointer(&profileState.buffers);
+    for (; buffer; buffer = buffer->next)
+    {
+        dropped += M_Atomic_Load(&buffer->dropped);
+    }
+    return dropped;
+}
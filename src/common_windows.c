@@ -17,6 +17,7 @@
 #include <windows.h> //needed for all the stuff to get the windows version
 #include <strsafe.h> //needed in the code written to get the windows version since I'm using a Microsoft provided string concatenation call-tje
 #include <io.h> //needed for getting the size of a file in windows
+#include <process.h> //needed for _beginthreadex
 
 bool os_Directory_Exists(const char * const pathToCheck)
 {
@@ -136,9 +137,8 @@ static uint16_t get_Console_Default_Color()
     return defaultConsoleAttributes;
 }
 
-void set_Console_Colors(bool foregroundBackground, eConsoleColors consoleColor)
+static void set_Console_Handle_Colors(HANDLE consoleHandle, bool foregroundBackground, eConsoleColors consoleColor)
 {
-    HANDLE consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
     WORD theColor = 0;
     if (foregroundBackground)//change foreground color
     {
@@ -261,6 +261,11 @@ void set_Console_Colors(bool foregroundBackground, eConsoleColors consoleColor)
     }
 }
 
+void set_Console_Colors(bool foregroundBackground, eConsoleColors consoleColor)
+{
+    set_Console_Handle_Colors(GetStdHandle(STD_OUTPUT_HANDLE), foregroundBackground, consoleColor);
+}
+
 eArchitecture get_Compiled_Architecture(void)
 {
     //check which compiler we're using to use it's preprocessor definitions
@@ -740,6 +745,64 @@ int64_t os_Get_File_Size(FILE *filePtr)
     }
 }
 
+int os_Map_File(FILE *filePtr, seaFileMapping *mapping)
+{
+    int64_t fileSize = 0;
+    HANDLE mappingHandle = NULL;
+    if (!filePtr || !mapping)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(mapping, 0, sizeof(seaFileMapping));
+    fileSize = os_Get_File_Size(filePtr);
+    if (fileSize < 0)
+    {
+        return FAILURE;
+    }
+    if ((uint64_t)fileSize > SIZE_MAX)
+    {
+        return NOT_SUPPORTED;
+    }
+    if (fileSize == 0)
+    {
+        //CreateFileMapping fails on an empty file
+        return SUCCESS;
+    }
+    mappingHandle = CreateFileMapping((HANDLE)_get_osfhandle(_fileno(filePtr)), NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mappingHandle)
+    {
+        return FAILURE;
+    }
+    mapping->data = (const uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!mapping->data)
+    {
+        CloseHandle(mappingHandle);
+        return FAILURE;
+    }
+    mapping->length = (uint64_t)fileSize;
+    mapping->osMappingHandle = mappingHandle;
+    return SUCCESS;
+}
+
+int os_Unmap_File(seaFileMapping *mapping)
+{
+    int ret = SUCCESS;
+    if (!mapping)
+    {
+        return BAD_PARAMETER;
+    }
+    if (mapping->data && !UnmapViewOfFile(mapping->data))
+    {
+        ret = FAILURE;
+    }
+    if (mapping->osMappingHandle && !CloseHandle((HANDLE)mapping->osMappingHandle))
+    {
+        ret = FAILURE;
+    }
+    memset(mapping, 0, sizeof(seaFileMapping));
+    return ret;
+}
+
 void start_Timer(seatimer_t *timer)
 {
     LARGE_INTEGER tempLargeInt;
@@ -797,3 +860,276 @@ void print_Windows_Error_To_Screen(unsigned int windowsError)
     printf("%u - %s\n", windowsError, windowsErrorString);
     LocalFree(windowsErrorString);
 }
+
+static unsigned __stdcall win_Thread_Start(void *threadParam)
+{
+    seathread_t *thread = (seathread_t*)threadParam;
+    thread->threadFunction(thread->threadData);
+    return 0;
+}
+
+int os_Create_Thread(seathread_t *thread, seathreadfunc_t threadFunction, void *threadData)
+{
+    if (!thread || !threadFunction)
+    {
+        return BAD_PARAMETER;
+    }
+    thread->threadFunction = threadFunction;
+    thread->threadData = threadData;
+    //_beginthreadex is used instead of CreateThread so that the CRT is setup properly for the new thread
+    thread->threadHandle = (HANDLE)_beginthreadex(NULL, 0, win_Thread_Start, thread, 0, NULL);
+    if (thread->threadHandle == 0)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int os_Join_Thread(seathread_t *thread)
+{
+    int ret = SUCCESS;
+    if (!thread || WAIT_OBJECT_0 != WaitForSingleObject(thread->threadHandle, INFINITE))
+    {
+        ret = FAILURE;
+    }
+    if (thread)
+    {
+        CloseHandle(thread->threadHandle);
+    }
+    return ret;
+}
+
+uint32_t os_Get_Processor_Count(void)
+{
+    SYSTEM_INFO system;
+    memset(&system, 0, sizeof(SYSTEM_INFO));
+    GetSystemInfo(&system);
+    if (system.dwNumberOfProcessors > 0)
+    {
+        return (uint32_t)system.dwNumberOfProcessors;
+    }
+    return 1;
+}
+
+void os_Yield_Thread(void)
+{
+    SwitchToThread();
+}
+
+#define WIN_RAW_OUTPUT_COPY_SIZE (64 * 1024) //chunk size when copying file data to the output
+
+static HANDLE get_Raw_Output_Handle(OutputInfo *outputInfo)
+{
+    FILE *outputFile = outputInfo->outputFilePtr ? outputInfo->outputFilePtr : stdout;
+    if (0 != fflush(outputFile))
+    {
+        return INVALID_HANDLE_VALUE;
+    }
+    //writing to the handle directly skips the CRT's buffering and text mode newline translation
+    return (HANDLE)_get_osfhandle(_fileno(outputFile));
+}
+
+static int write_Raw_Output_Handle(HANDLE outputHandle, const uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        DWORD written = 0;
+        DWORD writeLength = (DWORD)M_Min(length, UINT32_MAX);
+        if (!WriteFile(outputHandle, data, writeLength, &written, NULL) || written == 0)
+        {
+            return FAILURE;
+        }
+        data += written;
+        length -= written;
+    }
+    return SUCCESS;
+}
+
+//Windows has no equivalent of vmsplice, so zeroCopy is ignored and the buffers are always copied by WriteFile
+int os_Write_Raw_Output(OutputInfo *outputInfo, const tDataPtr *dataList, uint32_t dataCount, bool zeroCopy)
+{
+    HANDLE outputHandle = INVALID_HANDLE_VALUE;
+    uint32_t dataIndex = 0;
+    if (!outputInfo || (!dataList && dataCount > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    if (outputInfo->outputFormat != SEAC_OUTPUT_RAW)
+    {
+        return NOT_SUPPORTED;
+    }
+    for (dataIndex = 0; dataIndex < dataCount; ++dataIndex)
+    {
+        if (!dataList[dataIndex].pData && dataList[dataIndex].DataLen > 0)
+        {
+            return BAD_PARAMETER;
+        }
+    }
+    outputHandle = get_Raw_Output_Handle(outputInfo);
+    if (outputHandle == INVALID_HANDLE_VALUE)
+    {
+        return FAILURE;
+    }
+    for (dataIndex = 0; dataIndex < dataCount; ++dataIndex)
+    {
+        if (SUCCESS != write_Raw_Output_Handle(outputHandle, (const uint8_t*)dataList[dataIndex].pData, dataList[dataIndex].DataLen))
+        {
+            return FAILURE;
+        }
+    }
+    return SUCCESS;
+}
+
+int os_Write_Raw_File_Output(OutputInfo *outputInfo, FILE *inputFile, uint64_t length)
+{
+    int ret = SUCCESS;
+    HANDLE outputHandle = INVALID_HANDLE_VALUE;
+    uint8_t *copyBuffer = NULL;
+    if (!outputInfo || !inputFile)
+    {
+        return BAD_PARAMETER;
+    }
+    if (outputInfo->outputFormat != SEAC_OUTPUT_RAW)
+    {
+        return NOT_SUPPORTED;
+    }
+    outputHandle = get_Raw_Output_Handle(outputInfo);
+    if (outputHandle == INVALID_HANDLE_VALUE)
+    {
+        return FAILURE;
+    }
+    copyBuffer = (uint8_t*)malloc(WIN_RAW_OUTPUT_COPY_SIZE);
+    if (!copyBuffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (length > 0 && ret == SUCCESS)
+    {
+        size_t readLength = fread(copyBuffer, 1, (size_t)M_Min(length, WIN_RAW_OUTPUT_COPY_SIZE), inputFile);
+        if (readLength == 0)
+        {
+            ret = FAILURE;//end of file or read error before length bytes
+            break;
+        }
+        ret = write_Raw_Output_Handle(outputHandle, copyBuffer, readLength);
+        length -= readLength;
+    }
+    safe_Free(copyBuffer);
+    return ret;
+}
+
+#if !defined (ENABLE_VIRTUAL_TERMINAL_PROCESSING)
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004 //missing from SDKs before Windows 10
+#endif
+
+bool os_Is_Console_Output(FILE *outputFile)
+{
+    DWORD consoleMode = 0;
+    HANDLE outputHandle = INVALID_HANDLE_VALUE;
+    if (!outputFile)
+    {
+        return false;
+    }
+    outputHandle = (HANDLE)_get_osfhandle(_fileno(outputFile));
+    //GetConsoleMode fails for files and pipes
+    return (outputHandle != INVALID_HANDLE_VALUE && GetConsoleMode(outputHandle, &consoleMode));
+}
+
+//Turns on escape sequence handling in the console (Windows 10 and later) so that styled text can be written with one WriteFile
+static bool enable_Console_Escapes(HANDLE consoleHandle)
+{
+    DWORD consoleMode = 0;
+    if (!GetConsoleMode(consoleHandle, &consoleMode))
+    {
+        return false;
+    }
+    if (consoleMode & ENABLE_VIRTUAL_TERMINAL_PROCESSING)
+    {
+        return true;
+    }
+    return SetConsoleMode(consoleHandle, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) ? true : false;
+}
+
+//finds which color an escape sequence from get_Console_Color_Escape sets
+static bool find_Console_Color_Escape(const char *escape, size_t escapeLength, bool *foregroundBackground, eConsoleColors *consoleColor)
+{
+    for (uint32_t color = 0; color <= (uint32_t)DEFAULT; ++color)
+    {
+        const char *foregroundEscape = get_Console_Color_Escape(true, (eConsoleColors)color);
+        const char *backgroundEscape = get_Console_Color_Escape(false, (eConsoleColors)color);
+        if (strlen(foregroundEscape) == escapeLength && 0 == memcmp(foregroundEscape, escape, escapeLength))
+        {
+            *foregroundBackground = true;
+            *consoleColor = (eConsoleColors)color;
+            return true;
+        }
+        if (strlen(backgroundEscape) == escapeLength && 0 == memcmp(backgroundEscape, escape, escapeLength))
+        {
+            *foregroundBackground = false;
+            *consoleColor = (eConsoleColors)color;
+            return true;
+        }
+    }
+    return false;
+}
+
+int os_Write_Styled_Text(FILE *outputFile, const char *text, size_t length)
+{
+    HANDLE outputHandle = INVALID_HANDLE_VALUE;
+    if (!outputFile || (!text && length > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    if (!os_Is_Console_Output(outputFile))
+    {
+        //redirected output does not get colors, so there are no escape sequences. Going through the CRT keeps its text mode \n to \r\n translation.
+        if (length != fwrite(text, sizeof(char), length, outputFile))
+        {
+            return FAILURE;
+        }
+        return SUCCESS;
+    }
+    if (0 != fflush(outputFile))
+    {
+        return FAILURE;
+    }
+    outputHandle = (HANDLE)_get_osfhandle(_fileno(outputFile));
+    if (outputHandle == INVALID_HANDLE_VALUE)
+    {
+        return FAILURE;
+    }
+    if (enable_Console_Escapes(outputHandle))
+    {
+        //a console that understands the escape sequences, so write it all at once
+        return write_Raw_Output_Handle(outputHandle, (const uint8_t*)text, length);
+    }
+    //older consoles need SetConsoleTextAttribute for each color change, so write the text between the escape sequences separately
+    while (length > 0)
+    {
+        const char *escape = (const char*)memchr(text, '\033', length);
+        size_t textLength = escape ? (size_t)(escape - text) : length;
+        if (textLength > 0)
+        {
+            if (SUCCESS != write_Raw_Output_Handle(outputHandle, (const uint8_t*)text, textLength))
+            {
+                return FAILURE;
+            }
+            text += textLength;
+            length -= textLength;
+        }
+        if (escape)
+        {
+            const char *escapeEnd = (const char*)memchr(escape, 'm', length);
+            size_t escapeLength = escapeEnd ? (size_t)(escapeEnd - escape) + 1 : length;
+            bool foregroundBackground = true;
+            eConsoleColors consoleColor = DEFAULT;
+            if (find_Console_Color_Escape(escape, escapeLength, &foregroundBackground, &consoleColor))
+            {
+                set_Console_Handle_Colors(outputHandle, foregroundBackground, consoleColor);
+            }
+            text += escapeLength;
+            length -= escapeLength;
+        }
+    }
+    return SUCCESS;
+}